@@ -0,0 +1,18 @@
+#ifndef _HOST_ADAFRUIT_LIS3DH_H
+#define _HOST_ADAFRUIT_LIS3DH_H
+
+#include "Arduino.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// The accelerometer is declared by the sketch but never read; this stub only has to exist
+// ----------------------------------------------------------------------------------------------------------
+class Adafruit_LIS3DH {
+public:
+    Adafruit_LIS3DH(void) {}
+    bool begin(uint8_t addr = 0x18) {
+        (void)addr;
+        return false;
+    }
+};
+
+#endif // _HOST_ADAFRUIT_LIS3DH_H
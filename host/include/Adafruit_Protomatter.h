@@ -0,0 +1,106 @@
+#ifndef _HOST_ADAFRUIT_PROTOMATTER_H
+#define _HOST_ADAFRUIT_PROTOMATTER_H
+
+#include <Adafruit_GFX.h>
+
+#include <vector>
+
+// ----------------------------------------------------------------------------------------------------------
+// Stand-in for Adafruit_Protomatter: the same GFXcanvas16 framebuffer the sketch draws into, without the
+// HUB75 driver behind it; savePPM() dumps the framebuffer for inspection.
+//
+// As in the library, show() goes through the C core: _PM_convert_565() converts the framebuffer into bit
+// planes (here one byte of the six RGB bits per column, per plane, per pair of rows) in the buffer that isn't
+// being displayed, and _PM_swapbuffer_maybe() swaps the two. So it costs about what it does on the device,
+// and code that drives the core itself (protomatter_rows) runs here as it does there. Only the core's fields
+// that code uses are modelled, under the library's names, for one chain of panels; frameCount counts swaps.
+// ----------------------------------------------------------------------------------------------------------
+typedef enum {
+    PROTOMATTER_OK,
+    PROTOMATTER_ERR_PINS,
+    PROTOMATTER_ERR_MALLOC,
+    PROTOMATTER_ERR_ARG
+} ProtomatterStatus;
+
+typedef struct {
+    void *screenData;           // the bit planes: bufferSize bytes, twice if double-buffered
+    uint32_t bufferSize;        // bytes per buffer
+    volatile uint32_t frameCount;
+    uint16_t width;
+    uint16_t chainBits;         // columns across the chain
+    uint8_t bytesPerElement;
+    uint8_t numPlanes;
+    uint8_t numRowPairs;
+    uint8_t parallel;           // chains driven at once
+    bool doubleBuffer;
+    volatile uint8_t activeBuffer; // the one being displayed
+    int8_t tile;
+} Protomatter_core;
+
+extern "C" {
+void _PM_convert_565(Protomatter_core *core, uint16_t *source, uint16_t width);
+void _PM_swapbuffer_maybe(Protomatter_core *core);
+}
+
+// host only: row pairs converted by _PM_convert_565 so far
+uint32_t host_protomatter_row_pairs_converted(void);
+
+class Adafruit_Protomatter : public GFXcanvas16 {
+public:
+    Adafruit_Protomatter(uint16_t bitWidth, uint8_t bitDepth, uint8_t rgbCount, uint8_t *rgbList,
+                         uint8_t addrCount, uint8_t *addrList, uint8_t clockPin, uint8_t latchPin,
+                         uint8_t oePin, bool doubleBuffer, int8_t tile = 1, void *timer = NULL)
+        : GFXcanvas16(bitWidth, (2 << min((int)addrCount, 5)) * min((int)rgbCount, 5) * abs(tile)) {
+        (void)rgbList, (void)addrList, (void)clockPin, (void)latchPin, (void)oePin, (void)timer;
+        core = {};
+        core.width = core.chainBits = WIDTH;
+        core.bytesPerElement = 1;
+        core.numPlanes = bitDepth;
+        core.numRowPairs = HEIGHT / 2;
+        core.parallel = 1;
+        core.tile = 1;
+        core.doubleBuffer = doubleBuffer;
+        core.bufferSize = (uint32_t)core.numPlanes * core.chainBits * core.numRowPairs;
+        planes.resize(core.bufferSize * (doubleBuffer ? 2 : 1));
+        core.screenData = planes.data();
+    }
+
+    ProtomatterStatus begin(void) { return getBuffer() ? PROTOMATTER_OK : PROTOMATTER_ERR_MALLOC; }
+    void show(void) {
+        _PM_convert_565(&core, getBuffer(), WIDTH);
+        _PM_swapbuffer_maybe(&core);
+    }
+    uint32_t getFrameCount(void) { return core.frameCount; }
+
+    static uint16_t color565(uint8_t red, uint8_t green, uint8_t blue) {
+        return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+    }
+
+    // host only: the planes being displayed, row pair by row pair, plane by plane, column by column
+    const uint8_t *getPlanes(void) const {
+        return planes.data() + (core.doubleBuffer ? core.bufferSize * core.activeBuffer : 0);
+    }
+    uint8_t getBitDepth(void) const { return core.numPlanes; }
+
+    bool savePPM(const char *path) const {
+        FILE *fp = fopen(path, "wb");
+        if (!fp) return false;
+        fprintf(fp, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+        const uint16_t *p = getBuffer();
+        for (int32_t i = 0; i < WIDTH * HEIGHT; i++) {
+            uint16_t c = p[i];
+            uint8_t rgb[3] = {(uint8_t)(((c >> 11) * 255 + 15) / 31),
+                              (uint8_t)((((c >> 5) & 0x3F) * 255 + 31) / 63),
+                              (uint8_t)(((c & 0x1F) * 255 + 15) / 31)};
+            fwrite(rgb, 1, 3, fp);
+        }
+        fclose(fp);
+        return true;
+    }
+
+private:
+    Protomatter_core core;
+    std::vector<uint8_t> planes;
+};
+
+#endif // _HOST_ADAFRUIT_PROTOMATTER_H
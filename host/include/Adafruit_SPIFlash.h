@@ -0,0 +1,9 @@
+#ifndef _HOST_ADAFRUIT_SPIFLASH_H
+#define _HOST_ADAFRUIT_SPIFLASH_H
+
+// ----------------------------------------------------------------------------------------------------------
+// JvdW_ImageReader includes this for SPI flash file systems; the host reads through FS.h instead
+// ----------------------------------------------------------------------------------------------------------
+#include "FS.h"
+
+#endif // _HOST_ADAFRUIT_SPIFLASH_H
@@ -0,0 +1,117 @@
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+// ----------------------------------------------------------------------------------------------------------
+// Host (native) stand-in for the parts of the ESP32 Arduino core that the sketch and its libraries use.
+// Time is simulated: millis()/micros() only move when delay() is called or the host runner advances the
+// clock, so frame timings and scroll positions are reproducible from run to run.
+// ----------------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#define ARDUINO 10819
+#define HOST_BUILD 1
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+using std::abs;
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define LED_BUILTIN 13
+#define A1 1
+
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define PROGMEM
+#define PGM_P const char *
+#define F(string_literal) (string_literal)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_pointer(addr) (*(void *const *)(addr))
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+// ----------------------------------------------------------------------------------------------------------
+// Simulated clock
+// ----------------------------------------------------------------------------------------------------------
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void host_clock_advance_us(uint64_t us);
+uint64_t host_clock_us(void);
+
+// ----------------------------------------------------------------------------------------------------------
+// GPIO / ADC
+// ----------------------------------------------------------------------------------------------------------
+typedef enum {
+    ADC_0db,
+    ADC_2_5db,
+    ADC_6db,
+    ADC_11db
+} adc_attenuation_t;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+void analogSetAttenuation(adc_attenuation_t attenuation);
+
+void host_set_analog_value(uint8_t pin, uint16_t value);
+
+uint32_t esp_random(void);
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+// ----------------------------------------------------------------------------------------------------------
+// Time (ESP32 core helpers)
+// ----------------------------------------------------------------------------------------------------------
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+
+// Sketch entry points (host/src/host_main.cpp owns main())
+void setup(void);
+void loop(void);
+
+class EspClass {
+public:
+    uint32_t getFreeHeap(void);
+    uint32_t getMinFreeHeap(void);
+    uint32_t getHeapSize(void);
+    uint32_t getPsramSize(void);
+    uint32_t getFreePsram(void);
+};
+extern EspClass ESP;
+
+#endif // _HOST_ARDUINO_H
@@ -0,0 +1,68 @@
+#ifndef _HOST_FS_H
+#define _HOST_FS_H
+
+#include <memory>
+#include <string>
+
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// ----------------------------------------------------------------------------------------------------------
+// File backed by a stdio FILE*. Copies share the handle, like the ESP32 core's FileImplPtr.
+// ----------------------------------------------------------------------------------------------------------
+class File : public Stream {
+public:
+    File(void) {}
+    explicit File(FILE *fp);
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t *buf, size_t size);
+    size_t read(void *buf, size_t size) { return read((uint8_t *)buf, size); } // SdFat flavour, used by ImageReader off-ESP32
+    size_t readBytes(char *buffer, size_t length) override { return read((uint8_t *)buffer, length); }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const { return (bool)fp; }
+
+private:
+    std::shared_ptr<FILE> fp;
+};
+
+// ----------------------------------------------------------------------------------------------------------
+// File system rooted at a host directory
+// ----------------------------------------------------------------------------------------------------------
+class FS {
+public:
+    File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, const bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+
+protected:
+    std::string root = ".";
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+
+#endif // _HOST_FS_H
@@ -0,0 +1,76 @@
+#ifndef _HOST_HTTPCLIENT_H
+#define _HOST_HTTPCLIENT_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#include <string>
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_TOO_MANY_REQUESTS = 429,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503,
+} t_http_codes;
+
+// ----------------------------------------------------------------------------------------------------------
+// The part of the ESP32 core's HTTPClient the sketch uses, over the host's own network stack: plain http://
+// URLs only. Like the original, getStream() hands out the connection itself, positioned at the start of the
+// body (chunked bodies are not decoded there; getString() decodes them), and end() keeps the connection for
+// the next request when reuse is on and the server allows it, or closes it.
+// ----------------------------------------------------------------------------------------------------------
+class HTTPClient {
+public:
+    bool begin(const String &url);
+    void end(void);
+    int GET(void);
+
+    void useHTTP10(bool use = true) { http10 = use; }
+    void setReuse(bool reuse_connection) { reuse = reuse_connection; }
+    void setTimeout(uint16_t timeout_ms) { timeout = timeout_ms; }
+    void setConnectTimeout(int32_t timeout_ms) { connect_timeout = timeout_ms; }
+    void addHeader(const String &name, const String &value);
+    void collectHeaders(const char *header_keys[], const size_t count);
+    String header(const char *name);
+    bool hasHeader(const char *name);
+
+    int getSize(void) { return size; }
+    bool connected(void) { return client.connected(); }
+    WiFiClient &getStream(void) { return client; }
+    WiFiClient *getStreamPtr(void) { return client.connected() ? &client : NULL; }
+    String getString(void);
+    static String errorToString(int error);
+
+private:
+    struct Header_t
+    {
+        std::string name, value;
+    };
+
+    WiFiClient client;
+    std::string host, path, connected_host;
+    uint16_t port = 80, connected_port = 0;
+    bool http10 = false, reuse = true, can_reuse = false, chunked = false, body_read = false;
+    uint16_t timeout = 5000;
+    int32_t connect_timeout = 3000;
+    int size = -1;
+    uint32_t body_start = 0; // client.bytesRead() where the body began
+    std::vector<Header_t> request_headers, collected;
+};
+
+#endif // _HOST_HTTPCLIENT_H
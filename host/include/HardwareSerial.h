@@ -0,0 +1,29 @@
+#ifndef _HOST_HARDWARE_SERIAL_H
+#define _HOST_HARDWARE_SERIAL_H
+
+#include "Stream.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Serial goes to stderr so that the runner's report on stdout stays machine readable.
+// HOST_SERIAL_QUIET=1 in the environment silences it entirely.
+// ----------------------------------------------------------------------------------------------------------
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud);
+    void end(void) {}
+    operator bool() const { return true; }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+private:
+    bool quiet = false;
+};
+
+extern HardwareSerial Serial;
+
+#endif // _HOST_HARDWARE_SERIAL_H
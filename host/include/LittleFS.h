@@ -0,0 +1,22 @@
+#ifndef _HOST_LITTLEFS_H
+#define _HOST_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+// ----------------------------------------------------------------------------------------------------------
+// LittleFS mounted on the project's data/ directory (the same files `pio run -t uploadfs` would flash).
+// HOST_DATA_DIR in the environment points it somewhere else.
+// ----------------------------------------------------------------------------------------------------------
+class LittleFSFS : public FS {
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs");
+    void end(void) {}
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // _HOST_LITTLEFS_H
@@ -0,0 +1,75 @@
+#ifndef _HOST_PRINT_H
+#define _HOST_PRINT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "WString.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Arduino Print, as used by Adafruit_GFX text output and the Serial logging in the sketch
+// ----------------------------------------------------------------------------------------------------------
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            if (write(*buffer++))
+                n++;
+            else
+                break;
+        }
+        return n;
+    }
+    size_t write(const char *str) {
+        if (str == NULL) return 0;
+        return write((const uint8_t *)str, strlen(str));
+    }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        char loc_buf[64];
+        va_list arg;
+        va_start(arg, format);
+        int len = vsnprintf(loc_buf, sizeof(loc_buf), format, arg);
+        va_end(arg);
+        if (len < 0) return 0;
+        if ((size_t)len < sizeof(loc_buf)) return write((const uint8_t *)loc_buf, len);
+        char *temp = new char[len + 1];
+        va_start(arg, format);
+        vsnprintf(temp, len + 1, format, arg);
+        va_end(arg);
+        len = write((const uint8_t *)temp, len);
+        delete[] temp;
+        return len;
+    }
+
+    size_t print(const String &s) { return write(s.c_str(), s.length()); }
+    size_t print(const char str[]) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = 10) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = 10) { return print((unsigned long)n, base); }
+    size_t print(long n, int base = 10) { return base == 10 ? printf("%ld", n) : printf("%lx", n); }
+    size_t print(unsigned long n, int base = 10) { return base == 10 ? printf("%lu", n) : printf("%lx", n); }
+    size_t print(double n, int digits = 2) { return printf("%.*f", digits, n); }
+    size_t print(struct tm *timeinfo, const char *format = NULL) {
+        char buf[64];
+        size_t len = strftime(buf, sizeof(buf), format ? format : "%c", timeinfo);
+        return write(buf, len);
+    }
+
+    size_t println(void) { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { return print(value) + println(); }
+    size_t println(const char str[]) { return print(str) + println(); }
+    size_t println(struct tm *timeinfo, const char *format = NULL) { return print(timeinfo, format) + println(); }
+};
+
+#endif // _HOST_PRINT_H
@@ -0,0 +1,54 @@
+#ifndef _HOST_SPI_H
+#define _HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION 1
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+// ----------------------------------------------------------------------------------------------------------
+// SPI bus with nothing attached, enough for Adafruit_GFX's SPITFT and Adafruit BusIO to build natively
+// ----------------------------------------------------------------------------------------------------------
+class SPISettings {
+public:
+    SPISettings(void) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : _clock(clock), _bitOrder(bitOrder), _dataMode(dataMode) {}
+    uint32_t _clock = 1000000;
+    uint8_t _bitOrder = MSBFIRST;
+    uint8_t _dataMode = SPI_MODE0;
+};
+
+class SPIClass {
+public:
+    void begin(void) {}
+    void end(void) {}
+    void beginTransaction(SPISettings settings) { (void)settings; }
+    void endTransaction(void) {}
+    void setBitOrder(uint8_t bitOrder) { (void)bitOrder; }
+    void setDataMode(uint8_t dataMode) { (void)dataMode; }
+    void setFrequency(uint32_t freq) { (void)freq; }
+    void setClockDivider(uint32_t clockDiv) { (void)clockDiv; }
+    uint8_t transfer(uint8_t data) {
+        (void)data;
+        return 0xFF;
+    }
+    uint16_t transfer16(uint16_t data) {
+        (void)data;
+        return 0xFFFF;
+    }
+    void transfer(void *data, size_t count) { memset(data, 0xFF, count); }
+    void write(uint8_t data) { (void)data; }
+    void write16(uint16_t data) { (void)data; }
+    void write32(uint32_t data) { (void)data; }
+    void writeBytes(const uint8_t *data, uint32_t size) { (void)data, (void)size; }
+    void writePixels(const void *data, uint32_t size) { (void)data, (void)size; }
+};
+
+extern SPIClass SPI;
+
+#endif // _HOST_SPI_H
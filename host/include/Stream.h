@@ -0,0 +1,33 @@
+#ifndef _HOST_STREAM_H
+#define _HOST_STREAM_H
+
+#include "Print.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Arduino Stream: the blocking read helpers honour setTimeout() against the simulated clock
+// ----------------------------------------------------------------------------------------------------------
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout(void) const { return _timeout; }
+
+    virtual size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    String readString(void);
+    String readStringUntil(char terminator);
+
+    bool find(const char *target);
+    bool findUntil(const char *target, const char *terminator);
+
+protected:
+    int timedRead(void);
+    int timedPeek(void);
+
+    unsigned long _timeout = 1000;
+};
+
+#endif // _HOST_STREAM_H
@@ -0,0 +1,126 @@
+#ifndef _HOST_WSTRING_H
+#define _HOST_WSTRING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// ----------------------------------------------------------------------------------------------------------
+// Arduino String on top of std::string. Only the members used by the sketch and ArduinoJson are provided.
+// ----------------------------------------------------------------------------------------------------------
+class String {
+public:
+    String(void) {}
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const char *cstr, unsigned int length) : s(cstr, length) {}
+    String(const std::string &str) : s(str) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(int value, unsigned char base = 10) : s(base == 10 ? std::to_string(value) : to_base(value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : s(base == 10 ? std::to_string(value) : to_base(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : s(base == 10 ? std::to_string(value) : to_base(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : s(base == 10 ? std::to_string(value) : to_base(value, base)) {}
+    explicit String(float value, unsigned int decimalPlaces = 2) : s(format_float(value, decimalPlaces)) {}
+    explicit String(double value, unsigned int decimalPlaces = 2) : s(format_float(value, decimalPlaces)) {}
+
+    const char *c_str(void) const { return s.c_str(); }
+    unsigned int length(void) const { return (unsigned int)s.length(); }
+    bool isEmpty(void) const { return s.empty(); }
+    bool reserve(unsigned int size) {
+        s.reserve(size);
+        return true;
+    }
+
+    bool concat(const String &str) {
+        s += str.s;
+        return true;
+    }
+    bool concat(const char *cstr) {
+        if (cstr) s += cstr;
+        return true;
+    }
+    bool concat(const char *cstr, unsigned int length) {
+        if (cstr) s.append(cstr, length);
+        return true;
+    }
+    bool concat(char c) {
+        s += c;
+        return true;
+    }
+
+    String &operator+=(const String &rhs) {
+        concat(rhs);
+        return *this;
+    }
+    String &operator+=(const char *cstr) {
+        concat(cstr);
+        return *this;
+    }
+    String &operator+=(char c) {
+        concat(c);
+        return *this;
+    }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs.s + rhs.s); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs.s + (rhs ? rhs : "")); }
+    friend String operator+(const char *lhs, const String &rhs) { return String((lhs ? lhs : "") + rhs.s); }
+
+    bool equals(const String &rhs) const { return s == rhs.s; }
+    bool equals(const char *cstr) const { return s == (cstr ? cstr : ""); }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    bool startsWith(const String &prefix) const { return s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const {
+        return s.length() >= suffix.s.length() && s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0;
+    }
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t i = s.find(c, from);
+        return i == std::string::npos ? -1 : (int)i;
+    }
+    int indexOf(const String &str, unsigned int from = 0) const {
+        size_t i = s.find(str.s, from);
+        return i == std::string::npos ? -1 : (int)i;
+    }
+    String substring(unsigned int beginIndex) const { return beginIndex < s.length() ? String(s.substr(beginIndex)) : String(); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const {
+        if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+        if (beginIndex >= s.length()) return String();
+        return String(s.substr(beginIndex, endIndex - beginIndex));
+    }
+    void trim(void) {
+        size_t b = s.find_first_not_of(" \t\r\n"), e = s.find_last_not_of(" \t\r\n");
+        s = (b == std::string::npos) ? std::string() : s.substr(b, e - b + 1);
+    }
+    void toLowerCase(void) {
+        for (char &c : s) c = (char)tolower((unsigned char)c);
+    }
+    long toInt(void) const { return strtol(s.c_str(), NULL, 10); }
+    float toFloat(void) const { return strtof(s.c_str(), NULL); }
+
+private:
+    static std::string to_base(unsigned long value, unsigned char base) {
+        char buffer[8 * sizeof(unsigned long) + 1];
+        char *p = &buffer[sizeof(buffer) - 1];
+        *p = 0;
+        do {
+            unsigned long digit = value % base;
+            *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            value /= base;
+        } while (value);
+        return std::string(p);
+    }
+    static std::string format_float(double value, unsigned int decimalPlaces) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, value);
+        return std::string(buffer);
+    }
+
+    std::string s;
+};
+
+#endif // _HOST_WSTRING_H
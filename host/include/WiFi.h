@@ -0,0 +1,33 @@
+#ifndef _HOST_WIFI_H
+#define _HOST_WIFI_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// WiFi on the host is always connected (the host's own network stack is used directly)
+// ----------------------------------------------------------------------------------------------------------
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char *ssid, const char *passphrase = NULL) {
+        (void)ssid, (void)passphrase;
+        return WL_CONNECTED;
+    }
+    wl_status_t status(void) { return WL_CONNECTED; }
+    bool disconnect(bool wifioff = false) {
+        (void)wifioff;
+        return true;
+    }
+};
+
+extern WiFiClass WiFi;
+
+#endif // _HOST_WIFI_H
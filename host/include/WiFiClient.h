@@ -0,0 +1,45 @@
+#ifndef _HOST_WIFICLIENT_H
+#define _HOST_WIFICLIENT_H
+
+#include "Arduino.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------------------------------------
+// WiFiClient over a host TCP socket. As on the device, read() doesn't block: it returns -1 when nothing has
+// arrived. To keep Stream's timeouts (counted on the simulated clock, 1 ms per empty read) close to wall
+// time, an empty read first waits up to 1 ms of wall time for data.
+// ----------------------------------------------------------------------------------------------------------
+class WiFiClient : public Stream {
+public:
+    WiFiClient(void) {}
+    ~WiFiClient(void) { stop(); }
+    WiFiClient(const WiFiClient &) = delete;
+    WiFiClient &operator=(const WiFiClient &) = delete;
+
+    int connect(const char *host, uint16_t port, int32_t timeout_ms = 3000);
+    uint8_t connected(void);
+    void stop(void);
+
+    int available(void) override;
+    int read(void) override;
+    int peek(void) override;
+    int read(uint8_t *buffer, size_t size);
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    // host only: bytes handed out by read() since connect
+    uint32_t bytesRead(void) const { return bytes_read; }
+
+private:
+    bool fill(int wait_ms);
+
+    int fd = -1;
+    std::vector<uint8_t> rx;
+    size_t rx_pos = 0;
+    bool peer_closed = false;
+    uint32_t bytes_read = 0;
+};
+
+#endif // _HOST_WIFICLIENT_H
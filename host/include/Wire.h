@@ -0,0 +1,40 @@
+#ifndef _HOST_WIRE_H
+#define _HOST_WIRE_H
+
+#include "Arduino.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// I2C bus with nothing attached: every transfer NAKs
+// ----------------------------------------------------------------------------------------------------------
+class TwoWire : public Stream {
+public:
+    bool begin(void) { return true; }
+    bool begin(int sda, int scl, uint32_t frequency = 0) {
+        (void)sda, (void)scl, (void)frequency;
+        return true;
+    }
+    bool end(void) { return true; }
+    bool setClock(uint32_t frequency) {
+        (void)frequency;
+        return true;
+    }
+    void beginTransmission(uint8_t address) { (void)address; }
+    uint8_t endTransmission(bool sendStop = true) {
+        (void)sendStop;
+        return 2;
+    }
+    uint8_t requestFrom(uint8_t address, size_t size, bool sendStop = true) {
+        (void)address, (void)size, (void)sendStop;
+        return 0;
+    }
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t *, size_t size) override { return size; }
+    using Print::write;
+    int available(void) override { return 0; }
+    int read(void) override { return -1; }
+    int peek(void) override { return -1; }
+};
+
+extern TwoWire Wire;
+
+#endif // _HOST_WIRE_H
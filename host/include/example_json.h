@@ -0,0 +1,1515 @@
+#ifndef _HOST_EXAMPLE_JSON_H
+#define _HOST_EXAMPLE_JSON_H
+
+// ----------------------------------------------------------------------------------------------------------
+// Canned OpenWeatherMap responses for the host build (src/example_json.h takes precedence when it exists).
+// The forecast is a full 5 day / 3 hour response: 40 entries, roughly the size the panel downloads.
+// ----------------------------------------------------------------------------------------------------------
+const char *JSON_CURRENT_WEATHER = R"JSON({
+  "coord": {
+    "lon": 145.1667,
+    "lat": -38.1667
+  },
+  "weather": [
+    {
+      "id": 803,
+      "main": "Clouds",
+      "description": "broken clouds",
+      "icon": "04d"
+    }
+  ],
+  "base": "stations",
+  "main": {
+    "temp": 17.4,
+    "feels_like": 16.9,
+    "temp_min": 15.8,
+    "temp_max": 18.9,
+    "pressure": 1016,
+    "humidity": 68,
+    "sea_level": 1016,
+    "grnd_level": 1008
+  },
+  "visibility": 10000,
+  "wind": {
+    "speed": 5.14,
+    "deg": 200
+  },
+  "clouds": {
+    "all": 75
+  },
+  "dt": 1760572800,
+  "sys": {
+    "type": 2,
+    "id": 2008797,
+    "country": "AU",
+    "sunrise": 1760555043,
+    "sunset": 1760602167
+  },
+  "timezone": 39600,
+  "id": 2160517,
+  "name": "Langwarrin",
+  "cod": 200
+})JSON";
+
+const char *JSON_FORECAST_WEATHER = R"JSON({
+ "cod": "200",
+ "message": 0,
+ "cnt": 40,
+ "list": [
+  {
+   "dt": 1760583600,
+   "main": {
+    "temp": 15.0,
+    "feels_like": 14.4,
+    "temp_min": 14.0,
+    "temp_max": 15.4,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 60,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "04d"
+    }
+   ],
+   "clouds": {
+    "all": 0
+   },
+   "wind": {
+    "speed": 5.0,
+    "deg": 0,
+    "gust": 8.0
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-16 03:00:00"
+  },
+  {
+   "dt": 1760594400,
+   "main": {
+    "temp": 16.24,
+    "feels_like": 15.64,
+    "temp_min": 15.24,
+    "temp_max": 16.64,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 61,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "03d"
+    }
+   ],
+   "clouds": {
+    "all": 2
+   },
+   "wind": {
+    "speed": 4.83,
+    "deg": 37,
+    "gust": 7.73
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-16 06:00:00"
+  },
+  {
+   "dt": 1760605200,
+   "main": {
+    "temp": 17.4,
+    "feels_like": 16.8,
+    "temp_min": 16.4,
+    "temp_max": 17.8,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 62,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10d"
+    }
+   ],
+   "clouds": {
+    "all": 4
+   },
+   "wind": {
+    "speed": 4.36,
+    "deg": 74,
+    "gust": 6.98
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-16 09:00:00"
+  },
+  {
+   "dt": 1760616000,
+   "main": {
+    "temp": 18.41,
+    "feels_like": 17.81,
+    "temp_min": 17.41,
+    "temp_max": 18.81,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 63,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10n"
+    }
+   ],
+   "clouds": {
+    "all": 6
+   },
+   "wind": {
+    "speed": 3.62,
+    "deg": 111,
+    "gust": 5.79
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-16 12:00:00"
+  },
+  {
+   "dt": 1760626800,
+   "main": {
+    "temp": 19.21,
+    "feels_like": 18.61,
+    "temp_min": 18.21,
+    "temp_max": 19.61,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 64,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01n"
+    }
+   ],
+   "clouds": {
+    "all": 8
+   },
+   "wind": {
+    "speed": 2.71,
+    "deg": 148,
+    "gust": 4.34
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-16 15:00:00"
+  },
+  {
+   "dt": 1760637600,
+   "main": {
+    "temp": 19.74,
+    "feels_like": 19.14,
+    "temp_min": 18.74,
+    "temp_max": 20.14,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 65,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02n"
+    }
+   ],
+   "clouds": {
+    "all": 10
+   },
+   "wind": {
+    "speed": 2.29,
+    "deg": 185,
+    "gust": 3.66
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-16 18:00:00"
+  },
+  {
+   "dt": 1760648400,
+   "main": {
+    "temp": 19.99,
+    "feels_like": 19.39,
+    "temp_min": 18.99,
+    "temp_max": 20.39,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 66,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01d"
+    }
+   ],
+   "clouds": {
+    "all": 12
+   },
+   "wind": {
+    "speed": 3.25,
+    "deg": 222,
+    "gust": 5.2
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-16 21:00:00"
+  },
+  {
+   "dt": 1760659200,
+   "main": {
+    "temp": 19.92,
+    "feels_like": 19.32,
+    "temp_min": 18.92,
+    "temp_max": 20.32,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 67,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02d"
+    }
+   ],
+   "clouds": {
+    "all": 14
+   },
+   "wind": {
+    "speed": 4.07,
+    "deg": 259,
+    "gust": 6.51
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-17 00:00:00"
+  },
+  {
+   "dt": 1760670000,
+   "main": {
+    "temp": 19.55,
+    "feels_like": 18.95,
+    "temp_min": 18.55,
+    "temp_max": 19.95,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 68,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "09d"
+    }
+   ],
+   "clouds": {
+    "all": 16
+   },
+   "wind": {
+    "speed": 4.67,
+    "deg": 296,
+    "gust": 7.47
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-17 03:00:00"
+  },
+  {
+   "dt": 1760680800,
+   "main": {
+    "temp": 18.89,
+    "feels_like": 18.29,
+    "temp_min": 17.89,
+    "temp_max": 19.29,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 69,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "11d"
+    }
+   ],
+   "clouds": {
+    "all": 18
+   },
+   "wind": {
+    "speed": 4.97,
+    "deg": 333,
+    "gust": 7.95
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-17 06:00:00"
+  },
+  {
+   "dt": 1760691600,
+   "main": {
+    "temp": 17.99,
+    "feels_like": 17.39,
+    "temp_min": 16.99,
+    "temp_max": 18.39,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 70,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "13d"
+    }
+   ],
+   "clouds": {
+    "all": 20
+   },
+   "wind": {
+    "speed": 4.95,
+    "deg": 10,
+    "gust": 7.92
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-17 09:00:00"
+  },
+  {
+   "dt": 1760702400,
+   "main": {
+    "temp": 16.91,
+    "feels_like": 16.31,
+    "temp_min": 15.91,
+    "temp_max": 17.31,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 71,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "50n"
+    }
+   ],
+   "clouds": {
+    "all": 22
+   },
+   "wind": {
+    "speed": 4.6,
+    "deg": 47,
+    "gust": 7.36
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-17 12:00:00"
+  },
+  {
+   "dt": 1760713200,
+   "main": {
+    "temp": 15.71,
+    "feels_like": 15.11,
+    "temp_min": 14.71,
+    "temp_max": 16.11,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 72,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "04n"
+    }
+   ],
+   "clouds": {
+    "all": 24
+   },
+   "wind": {
+    "speed": 3.96,
+    "deg": 84,
+    "gust": 6.34
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-17 15:00:00"
+  },
+  {
+   "dt": 1760724000,
+   "main": {
+    "temp": 14.46,
+    "feels_like": 13.86,
+    "temp_min": 13.46,
+    "temp_max": 14.86,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 73,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "03n"
+    }
+   ],
+   "clouds": {
+    "all": 26
+   },
+   "wind": {
+    "speed": 3.11,
+    "deg": 121,
+    "gust": 4.98
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-17 18:00:00"
+  },
+  {
+   "dt": 1760734800,
+   "main": {
+    "temp": 13.25,
+    "feels_like": 12.65,
+    "temp_min": 12.25,
+    "temp_max": 13.65,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 74,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01d"
+    }
+   ],
+   "clouds": {
+    "all": 28
+   },
+   "wind": {
+    "speed": 2.14,
+    "deg": 158,
+    "gust": 3.42
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-17 21:00:00"
+  },
+  {
+   "dt": 1760745600,
+   "main": {
+    "temp": 12.14,
+    "feels_like": 11.54,
+    "temp_min": 11.14,
+    "temp_max": 12.54,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 75,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10d"
+    }
+   ],
+   "clouds": {
+    "all": 30
+   },
+   "wind": {
+    "speed": 2.85,
+    "deg": 195,
+    "gust": 4.56
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-18 00:00:00"
+  },
+  {
+   "dt": 1760756400,
+   "main": {
+    "temp": 11.22,
+    "feels_like": 10.62,
+    "temp_min": 10.22,
+    "temp_max": 11.62,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 76,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "04d"
+    }
+   ],
+   "clouds": {
+    "all": 32
+   },
+   "wind": {
+    "speed": 3.75,
+    "deg": 232,
+    "gust": 6.0
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-18 03:00:00"
+  },
+  {
+   "dt": 1760767200,
+   "main": {
+    "temp": 10.53,
+    "feels_like": 9.93,
+    "temp_min": 9.53,
+    "temp_max": 10.93,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 77,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "03d"
+    }
+   ],
+   "clouds": {
+    "all": 34
+   },
+   "wind": {
+    "speed": 4.45,
+    "deg": 269,
+    "gust": 7.12
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-18 06:00:00"
+  },
+  {
+   "dt": 1760778000,
+   "main": {
+    "temp": 10.11,
+    "feels_like": 9.51,
+    "temp_min": 9.11,
+    "temp_max": 10.51,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 78,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10d"
+    }
+   ],
+   "clouds": {
+    "all": 36
+   },
+   "wind": {
+    "speed": 4.88,
+    "deg": 306,
+    "gust": 7.81
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-18 09:00:00"
+  },
+  {
+   "dt": 1760788800,
+   "main": {
+    "temp": 10.0,
+    "feels_like": 9.4,
+    "temp_min": 9.0,
+    "temp_max": 10.4,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 79,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10n"
+    }
+   ],
+   "clouds": {
+    "all": 38
+   },
+   "wind": {
+    "speed": 5.0,
+    "deg": 343,
+    "gust": 8.0
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-18 12:00:00"
+  },
+  {
+   "dt": 1760799600,
+   "main": {
+    "temp": 10.21,
+    "feels_like": 9.61,
+    "temp_min": 9.21,
+    "temp_max": 10.61,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 80,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01n"
+    }
+   ],
+   "clouds": {
+    "all": 40
+   },
+   "wind": {
+    "speed": 4.78,
+    "deg": 20,
+    "gust": 7.65
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-18 15:00:00"
+  },
+  {
+   "dt": 1760810400,
+   "main": {
+    "temp": 10.71,
+    "feels_like": 10.11,
+    "temp_min": 9.71,
+    "temp_max": 11.11,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 81,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02n"
+    }
+   ],
+   "clouds": {
+    "all": 42
+   },
+   "wind": {
+    "speed": 4.26,
+    "deg": 57,
+    "gust": 6.82
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-18 18:00:00"
+  },
+  {
+   "dt": 1760821200,
+   "main": {
+    "temp": 11.47,
+    "feels_like": 10.87,
+    "temp_min": 10.47,
+    "temp_max": 11.87,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 82,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01d"
+    }
+   ],
+   "clouds": {
+    "all": 44
+   },
+   "wind": {
+    "speed": 3.49,
+    "deg": 94,
+    "gust": 5.58
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-18 21:00:00"
+  },
+  {
+   "dt": 1760832000,
+   "main": {
+    "temp": 12.46,
+    "feels_like": 11.86,
+    "temp_min": 11.46,
+    "temp_max": 12.86,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 83,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02d"
+    }
+   ],
+   "clouds": {
+    "all": 46
+   },
+   "wind": {
+    "speed": 2.56,
+    "deg": 131,
+    "gust": 4.1
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-19 00:00:00"
+  },
+  {
+   "dt": 1760842800,
+   "main": {
+    "temp": 13.6,
+    "feels_like": 13.0,
+    "temp_min": 12.6,
+    "temp_max": 14.0,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 84,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "09d"
+    }
+   ],
+   "clouds": {
+    "all": 48
+   },
+   "wind": {
+    "speed": 2.44,
+    "deg": 168,
+    "gust": 3.9
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-19 03:00:00"
+  },
+  {
+   "dt": 1760853600,
+   "main": {
+    "temp": 14.83,
+    "feels_like": 14.23,
+    "temp_min": 13.83,
+    "temp_max": 15.23,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 85,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "11d"
+    }
+   ],
+   "clouds": {
+    "all": 50
+   },
+   "wind": {
+    "speed": 3.38,
+    "deg": 205,
+    "gust": 5.41
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-19 06:00:00"
+  },
+  {
+   "dt": 1760864400,
+   "main": {
+    "temp": 16.08,
+    "feels_like": 15.48,
+    "temp_min": 15.08,
+    "temp_max": 16.48,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 86,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "13d"
+    }
+   ],
+   "clouds": {
+    "all": 52
+   },
+   "wind": {
+    "speed": 4.18,
+    "deg": 242,
+    "gust": 6.69
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-19 09:00:00"
+  },
+  {
+   "dt": 1760875200,
+   "main": {
+    "temp": 17.25,
+    "feels_like": 16.65,
+    "temp_min": 16.25,
+    "temp_max": 17.65,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 87,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "50n"
+    }
+   ],
+   "clouds": {
+    "all": 54
+   },
+   "wind": {
+    "speed": 4.73,
+    "deg": 279,
+    "gust": 7.57
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-19 12:00:00"
+  },
+  {
+   "dt": 1760886000,
+   "main": {
+    "temp": 18.28,
+    "feels_like": 17.68,
+    "temp_min": 17.28,
+    "temp_max": 18.68,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 88,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "04n"
+    }
+   ],
+   "clouds": {
+    "all": 56
+   },
+   "wind": {
+    "speed": 4.99,
+    "deg": 316,
+    "gust": 7.98
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-19 15:00:00"
+  },
+  {
+   "dt": 1760896800,
+   "main": {
+    "temp": 19.12,
+    "feels_like": 18.52,
+    "temp_min": 18.12,
+    "temp_max": 19.52,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 89,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "03n"
+    }
+   ],
+   "clouds": {
+    "all": 58
+   },
+   "wind": {
+    "speed": 4.91,
+    "deg": 353,
+    "gust": 7.86
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-19 18:00:00"
+  },
+  {
+   "dt": 1760907600,
+   "main": {
+    "temp": 19.69,
+    "feels_like": 19.09,
+    "temp_min": 18.69,
+    "temp_max": 20.09,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 60,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01d"
+    }
+   ],
+   "clouds": {
+    "all": 60
+   },
+   "wind": {
+    "speed": 4.52,
+    "deg": 30,
+    "gust": 7.23
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-19 21:00:00"
+  },
+  {
+   "dt": 1760918400,
+   "main": {
+    "temp": 19.97,
+    "feels_like": 19.37,
+    "temp_min": 18.97,
+    "temp_max": 20.37,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 61,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10d"
+    }
+   ],
+   "clouds": {
+    "all": 62
+   },
+   "wind": {
+    "speed": 3.84,
+    "deg": 67,
+    "gust": 6.14
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-20 00:00:00"
+  },
+  {
+   "dt": 1760929200,
+   "main": {
+    "temp": 19.95,
+    "feels_like": 19.35,
+    "temp_min": 18.95,
+    "temp_max": 20.35,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 62,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "04d"
+    }
+   ],
+   "clouds": {
+    "all": 64
+   },
+   "wind": {
+    "speed": 2.97,
+    "deg": 104,
+    "gust": 4.75
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-20 03:00:00"
+  },
+  {
+   "dt": 1760940000,
+   "main": {
+    "temp": 19.61,
+    "feels_like": 19.01,
+    "temp_min": 18.61,
+    "temp_max": 20.01,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 63,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "03d"
+    }
+   ],
+   "clouds": {
+    "all": 66
+   },
+   "wind": {
+    "speed": 2.01,
+    "deg": 141,
+    "gust": 3.22
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-20 06:00:00"
+  },
+  {
+   "dt": 1760950800,
+   "main": {
+    "temp": 18.99,
+    "feels_like": 18.39,
+    "temp_min": 17.99,
+    "temp_max": 19.39,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 64,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10d"
+    }
+   ],
+   "clouds": {
+    "all": 68
+   },
+   "wind": {
+    "speed": 2.99,
+    "deg": 178,
+    "gust": 4.78
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-20 09:00:00"
+  },
+  {
+   "dt": 1760961600,
+   "main": {
+    "temp": 18.12,
+    "feels_like": 17.52,
+    "temp_min": 17.12,
+    "temp_max": 18.52,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 65,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "10n"
+    }
+   ],
+   "clouds": {
+    "all": 70
+   },
+   "wind": {
+    "speed": 3.87,
+    "deg": 215,
+    "gust": 6.19
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-20 12:00:00"
+  },
+  {
+   "dt": 1760972400,
+   "main": {
+    "temp": 17.06,
+    "feels_like": 16.46,
+    "temp_min": 16.06,
+    "temp_max": 17.46,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 66,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01n"
+    }
+   ],
+   "clouds": {
+    "all": 72
+   },
+   "wind": {
+    "speed": 4.53,
+    "deg": 252,
+    "gust": 7.25
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-20 15:00:00"
+  },
+  {
+   "dt": 1760983200,
+   "main": {
+    "temp": 15.87,
+    "feels_like": 15.27,
+    "temp_min": 14.87,
+    "temp_max": 16.27,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 67,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02n"
+    }
+   ],
+   "clouds": {
+    "all": 74
+   },
+   "wind": {
+    "speed": 4.92,
+    "deg": 289,
+    "gust": 7.87
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "n"
+   },
+   "dt_txt": "2025-10-20 18:00:00"
+  },
+  {
+   "dt": 1760994000,
+   "main": {
+    "temp": 14.62,
+    "feels_like": 14.02,
+    "temp_min": 13.62,
+    "temp_max": 15.02,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 68,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "01d"
+    }
+   ],
+   "clouds": {
+    "all": 76
+   },
+   "wind": {
+    "speed": 4.98,
+    "deg": 326,
+    "gust": 7.97
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-20 21:00:00"
+  },
+  {
+   "dt": 1761004800,
+   "main": {
+    "temp": 13.4,
+    "feels_like": 12.8,
+    "temp_min": 12.4,
+    "temp_max": 13.8,
+    "pressure": 1015,
+    "sea_level": 1015,
+    "grnd_level": 1007,
+    "humidity": 69,
+    "temp_kf": 0.4
+   },
+   "weather": [
+    {
+     "id": 800,
+     "main": "Clear",
+     "description": "clear sky",
+     "icon": "02d"
+    }
+   ],
+   "clouds": {
+    "all": 78
+   },
+   "wind": {
+    "speed": 4.72,
+    "deg": 3,
+    "gust": 7.55
+   },
+   "visibility": 10000,
+   "pop": 0.12,
+   "sys": {
+    "pod": "d"
+   },
+   "dt_txt": "2025-10-21 00:00:00"
+  }
+ ],
+ "city": {
+  "id": 2160517,
+  "name": "Langwarrin",
+  "coord": {
+   "lat": -38.1667,
+   "lon": 145.1667
+  },
+  "country": "AU",
+  "population": 0,
+  "timezone": 39600,
+  "sunrise": 1760555043,
+  "sunset": 1760602167
+ }
+})JSON";
+
+#endif // _HOST_EXAMPLE_JSON_H
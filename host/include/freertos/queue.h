@@ -0,0 +1,18 @@
+#ifndef _HOST_FREERTOS_QUEUE_H
+#define _HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// FreeRTOS queues on the host: fixed-size items copied in and out under a mutex. They work between real
+// threads, so a runner that starts one in place of a task can use them; waits are in real milliseconds.
+// ----------------------------------------------------------------------------------------------------------
+typedef struct HostQueue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+void vQueueDelete(QueueHandle_t xQueue);
+
+#endif // _HOST_FREERTOS_QUEUE_H
@@ -0,0 +1,31 @@
+#ifndef _HOST_RUNTIME_H
+#define _HOST_RUNTIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Host-only hooks used by the benchmark runner
+// ----------------------------------------------------------------------------------------------------------
+struct HostAllocStats_t
+{
+    uint64_t allocs;       // malloc/calloc/realloc/new calls
+    uint64_t frees;        // free/delete calls
+    uint64_t bytes;        // bytes requested
+    uint64_t psram_allocs; // heap_caps_malloc(MALLOC_CAP_SPIRAM) calls
+    uint64_t psram_bytes;
+    uint64_t live_bytes;   // allocated and not yet freed
+    uint64_t peak_bytes;   // highest live_bytes since the start or host_alloc_reset_peak
+};
+
+// Snapshot of the allocation counters (monotonic, apart from live_bytes and peak_bytes; diff two snapshots to
+// measure a region)
+HostAllocStats_t host_alloc_stats(void);
+
+// Start measuring the peak from the bytes live now
+void host_alloc_reset_peak(void);
+
+// Wall-clock nanoseconds, for timing work (the simulated millis() clock is for the sketch only)
+uint64_t host_wall_ns(void);
+
+#endif // _HOST_RUNTIME_H
@@ -0,0 +1,11 @@
+#ifndef _HOST_SECRETS_H
+#define _HOST_SECRETS_H
+
+// ----------------------------------------------------------------------------------------------------------
+// Placeholder credentials for the host build (src/secrets.h takes precedence when it exists)
+// ----------------------------------------------------------------------------------------------------------
+#define WIFI_SSID "host"
+#define WIFI_PASSWORD "host"
+#define OPENWEATHER_TOKEN "host"
+
+#endif // _HOST_SECRETS_H
@@ -0,0 +1,35 @@
+#ifndef _HOST_BENCH_H
+#define _HOST_BENCH_H
+
+#include <Arduino.h>
+
+#include <functional>
+
+#include "host_runtime.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Benchmark helpers for the host runner. Each measurement runs `body` once per iteration, timing every
+// iteration individually and counting heap allocations, and prints one report line to stdout.
+// ----------------------------------------------------------------------------------------------------------
+struct BenchResult_t
+{
+    uint32_t iterations;
+    double mean_ns, p50_ns, p99_ns, min_ns;
+    double allocs_per_iter, bytes_per_iter;
+};
+
+// units_per_iter / unit: optional throughput column, e.g. 4096 "px" reports pixels per microsecond
+BenchResult_t bench_measure(const char *name, uint32_t iterations, const std::function<void()> &body,
+                            double units_per_iter = 0, const char *unit = NULL);
+
+// Print a free-form report line, aligned with the measurement lines
+void bench_note(const char *name, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Count a check and give the word to print for it: pass if ok, else "NO". The runner exits with 1 when any
+// check has failed, so the notes that report one go through this.
+const char *bench_check(const char *name, bool ok, const char *pass = "yes");
+
+// True when the runner was asked to run this group (--only <group> filters, default runs all)
+bool bench_selected(const char *group);
+
+#endif // _HOST_BENCH_H
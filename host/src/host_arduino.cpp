@@ -0,0 +1,398 @@
+#include <Arduino.h>
+
+#include <FS.h>
+#include <LittleFS.h>
+#include <SPI.h>
+#include <WiFi.h>
+#include <Wire.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <random>
+
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include <freertos/queue.h>
+
+#include "host_runtime.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Allocation accounting. malloc & friends are intercepted with the linker's --wrap (see [env:native]).
+// Live bytes are counted by the allocator's usable size, so they can be a little above what was asked for;
+// memory that libc allocates internally isn't seen.
+// ----------------------------------------------------------------------------------------------------------
+static std::atomic<uint64_t> alloc_count{0}, free_count{0}, alloc_bytes{0}, psram_count{0}, psram_bytes{0};
+static std::atomic<int64_t> live_bytes{0}, peak_bytes{0};
+
+static void *track_alloc(void *p) {
+    if (p) {
+        int64_t live = live_bytes += malloc_usable_size(p), peak = peak_bytes.load();
+        while (live > peak && !peak_bytes.compare_exchange_weak(peak, live)) {
+        }
+    }
+    return p;
+}
+
+static void track_free(void *p) {
+    if (p) live_bytes -= malloc_usable_size(p);
+}
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    return track_alloc(__real_malloc(size));
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+    alloc_count++;
+    alloc_bytes += n * size;
+    return track_alloc(__real_calloc(n, size));
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    alloc_bytes += size;
+    track_free(ptr);
+    return track_alloc(__real_realloc(ptr, size));
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr) free_count++;
+    track_free(ptr);
+    __real_free(ptr);
+}
+}
+
+void *operator new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+HostAllocStats_t host_alloc_stats(void) {
+    return {alloc_count.load(), free_count.load(), alloc_bytes.load(), psram_count.load(), psram_bytes.load(),
+            (uint64_t)max((int64_t)0, live_bytes.load()), (uint64_t)max((int64_t)0, peak_bytes.load())};
+}
+
+void host_alloc_reset_peak(void) {
+    peak_bytes = live_bytes.load();
+}
+
+uint64_t host_wall_ns(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// heap_caps
+// ----------------------------------------------------------------------------------------------------------
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        psram_count++;
+        psram_bytes += size;
+    }
+    return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    void *p = heap_caps_malloc(n * size, caps);
+    if (p) memset(p, 0, n * size);
+    return p;
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        psram_count++;
+        psram_bytes += size;
+    }
+    alloc_count++;
+    alloc_bytes += size;
+    return track_alloc(aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment));
+}
+
+void heap_caps_free(void *ptr) { free(ptr); }
+
+// internal RAM is a 320 KB heap that everything is allocated from; PSRAM is always free
+static const int64_t HOST_HEAP_BYTES = 320 * 1024;
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 8 * 1024 * 1024 : max((int64_t)0, HOST_HEAP_BYTES - live_bytes.load());
+}
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 8 * 1024 * 1024 : max((int64_t)0, HOST_HEAP_BYTES - peak_bytes.load());
+}
+
+EspClass ESP;
+uint32_t EspClass::getFreeHeap(void) { return heap_caps_get_free_size(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getMinFreeHeap(void) { return heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL); }
+uint32_t EspClass::getHeapSize(void) { return 320 * 1024; }
+uint32_t EspClass::getPsramSize(void) { return 8 * 1024 * 1024; }
+uint32_t EspClass::getFreePsram(void) { return heap_caps_get_free_size(MALLOC_CAP_SPIRAM); }
+
+// ----------------------------------------------------------------------------------------------------------
+// Simulated clock
+// ----------------------------------------------------------------------------------------------------------
+static std::atomic<uint64_t> clock_us{0};
+
+void host_clock_advance_us(uint64_t us) { clock_us += us; }
+uint64_t host_clock_us(void) { return clock_us.load(); }
+
+unsigned long millis(void) { return (unsigned long)(clock_us.load() / 1000); }
+unsigned long micros(void) { return (unsigned long)clock_us.load(); }
+void delay(uint32_t ms) { clock_us += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { clock_us += us; }
+void yield(void) {}
+
+// ----------------------------------------------------------------------------------------------------------
+// GPIO / ADC / RNG
+// ----------------------------------------------------------------------------------------------------------
+static uint16_t analog_values[64];
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return LOW; }
+uint16_t analogRead(uint8_t pin) { return analog_values[pin & 63]; }
+void analogSetAttenuation(adc_attenuation_t) {}
+void host_set_analog_value(uint8_t pin, uint16_t value) { analog_values[pin & 63] = value; }
+
+static std::mt19937 rng(0x5EED);
+uint32_t esp_random(void) { return rng(); }
+long random(long howbig) { return howbig > 0 ? (long)(rng() % howbig) : 0; }
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+
+// ----------------------------------------------------------------------------------------------------------
+// Time
+// ----------------------------------------------------------------------------------------------------------
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *, const char *, const char *) {
+    (void)gmtOffset_sec, (void)daylightOffset_sec;
+}
+
+bool getLocalTime(struct tm *info, uint32_t) {
+    time_t now = time(NULL);
+    return localtime_r(&now, info) != NULL;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// FreeRTOS
+// ----------------------------------------------------------------------------------------------------------
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *pcName, uint32_t, void *, UBaseType_t, TaskHandle_t *pvCreatedTask, BaseType_t) {
+    if (pvCreatedTask) *pvCreatedTask = (TaskHandle_t)pcName;
+    return pdPASS;
+}
+void vTaskDelay(TickType_t xTicksToDelay) { delay(xTicksToDelay * portTICK_PERIOD_MS); }
+TickType_t xTaskGetTickCount(void) { return (TickType_t)(millis() / portTICK_PERIOD_MS); }
+BaseType_t xPortGetCoreID(void) { return 1; }
+
+struct HostQueue
+{
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<std::string> items;
+    size_t length, item_size;
+};
+
+// Wait until ready() holds, for ticks milliseconds at most; the lock is held on return
+template <typename Ready>
+static bool queue_wait(HostQueue *q, std::unique_lock<std::mutex> &hold, TickType_t ticks, Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        q->changed.wait(hold, ready);
+        return true;
+    }
+    return q->changed.wait_for(hold, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    HostQueue *q = new HostQueue();
+    q->length = uxQueueLength;
+    q->item_size = uxItemSize;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *pvItemToQueue, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> hold(q->lock);
+    if (!queue_wait(q, hold, xTicksToWait, [q] { return q->items.size() < q->length; })) return pdFAIL;
+    q->items.emplace_back((const char *)pvItemToQueue, q->item_size);
+    q->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *pvBuffer, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> hold(q->lock);
+    if (!queue_wait(q, hold, xTicksToWait, [q] { return !q->items.empty(); })) return pdFALSE;
+    memcpy(pvBuffer, q->items.front().data(), q->item_size);
+    q->items.pop_front();
+    q->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> hold(q->lock);
+    return q->items.size();
+}
+
+void vQueueDelete(QueueHandle_t q) { delete q; }
+
+// ----------------------------------------------------------------------------------------------------------
+// Stream
+// ----------------------------------------------------------------------------------------------------------
+int Stream::timedRead(void) {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+int Stream::timedPeek(void) {
+    unsigned long start = millis();
+    do {
+        int c = peek();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        *buffer++ = (char)c;
+        count++;
+    }
+    return count;
+}
+
+String Stream::readString(void) {
+    String ret;
+    int c;
+    while ((c = timedRead()) >= 0) ret += (char)c;
+    return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int c;
+    while ((c = timedRead()) >= 0 && c != terminator) ret += (char)c;
+    return ret;
+}
+
+bool Stream::find(const char *target) { return findUntil(target, NULL); }
+
+bool Stream::findUntil(const char *target, const char *terminator) {
+    size_t target_len = strlen(target), term_len = terminator ? strlen(terminator) : 0;
+    size_t index = 0, term_index = 0;
+    int c;
+    while ((c = timedRead()) >= 0) {
+        if (c == target[index]) {
+            if (++index >= target_len) return true;
+        } else {
+            index = (c == target[0]) ? 1 : 0;
+        }
+        if (term_len) {
+            if (c == terminator[term_index]) {
+                if (++term_index >= term_len) return false;
+            } else {
+                term_index = (c == terminator[0]) ? 1 : 0;
+            }
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Serial
+// ----------------------------------------------------------------------------------------------------------
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long) {
+    const char *q = getenv("HOST_SERIAL_QUIET");
+    quiet = q && *q && *q != '0';
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (!quiet) fputc(c, stderr);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    if (!quiet) fwrite(buffer, 1, size, stderr);
+    return size;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// File system
+// ----------------------------------------------------------------------------------------------------------
+namespace fs {
+
+File::File(FILE *f) : fp(f, [](FILE *p) { fclose(p); }) {}
+
+size_t File::write(uint8_t c) { return fp ? fwrite(&c, 1, 1, fp.get()) : 0; }
+size_t File::write(const uint8_t *buf, size_t size) { return fp ? fwrite(buf, 1, size, fp.get()) : 0; }
+int File::available() { return fp ? (int)(size() - position()) : 0; }
+int File::read() { return fp ? fgetc(fp.get()) : -1; }
+int File::peek() {
+    if (!fp) return -1;
+    int c = fgetc(fp.get());
+    if (c >= 0) ungetc(c, fp.get());
+    return c;
+}
+size_t File::read(uint8_t *buf, size_t size) { return fp ? fread(buf, 1, size, fp.get()) : 0; }
+bool File::seek(uint32_t pos, SeekMode mode) { return fp && fseek(fp.get(), pos, mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END)) == 0; }
+size_t File::position() const { return fp ? (size_t)ftell(fp.get()) : 0; }
+size_t File::size() const {
+    if (!fp) return 0;
+    long here = ftell(fp.get());
+    fseek(fp.get(), 0, SEEK_END);
+    long end = ftell(fp.get());
+    fseek(fp.get(), here, SEEK_SET);
+    return (size_t)end;
+}
+void File::close() { fp.reset(); }
+
+File FS::open(const char *path, const char *mode, const bool) {
+    std::string full = root + (path[0] == '/' ? "" : "/") + path;
+    std::string m = std::string(mode) + "b";
+    return File(fopen(full.c_str(), m.c_str()));
+}
+
+bool FS::exists(const char *path) {
+    struct stat st;
+    std::string full = root + (path[0] == '/' ? "" : "/") + path;
+    return stat(full.c_str(), &st) == 0;
+}
+
+bool LittleFSFS::begin(bool, const char *, uint8_t, const char *) {
+    const char *dir = getenv("HOST_DATA_DIR");
+    root = dir ? dir : "data";
+    return exists("/");
+}
+
+} // namespace fs
+
+fs::LittleFSFS LittleFS;
+
+// ----------------------------------------------------------------------------------------------------------
+// Buses
+// ----------------------------------------------------------------------------------------------------------
+WiFiClass WiFi;
+TwoWire Wire;
+SPIClass SPI;
@@ -0,0 +1,285 @@
+#include <Arduino.h>
+
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// WiFiClient
+// ----------------------------------------------------------------------------------------------------------
+int WiFiClient::connect(const char *host, uint16_t port, int32_t timeout_ms) {
+    stop();
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+    struct addrinfo hints = {}, *addresses = NULL;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, service, &hints, &addresses) != 0) return 0;
+
+    for (struct addrinfo *a = addresses; a != NULL && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype | SOCK_NONBLOCK, a->ai_protocol);
+        if (fd < 0) continue;
+        int done = ::connect(fd, a->ai_addr, a->ai_addrlen);
+        if (done < 0 && errno == EINPROGRESS) {
+            struct pollfd p = {fd, POLLOUT, 0};
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (poll(&p, 1, timeout_ms) == 1 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0) {
+                done = 0;
+            }
+        }
+        if (done < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) return 0;
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    rx.clear();
+    rx_pos = 0;
+    peer_closed = false;
+    bytes_read = 0;
+    return 1;
+}
+
+void WiFiClient::stop(void) {
+    if (fd >= 0) close(fd);
+    fd = -1;
+    rx.clear();
+    rx_pos = 0;
+}
+
+// Read what has arrived into the buffer, waiting up to wait_ms for something; false if nothing came
+bool WiFiClient::fill(int wait_ms) {
+    if (rx_pos < rx.size()) return true;
+    if (fd < 0 || peer_closed) return false;
+    rx.resize(4096);
+    rx_pos = 0;
+    struct pollfd p = {fd, POLLIN, 0};
+    ssize_t n = -1;
+    if (poll(&p, 1, wait_ms) == 1) n = recv(fd, rx.data(), rx.size(), 0);
+    if (n == 0) peer_closed = true;
+    rx.resize(n > 0 ? n : 0);
+    return n > 0;
+}
+
+uint8_t WiFiClient::connected(void) {
+    if (rx_pos < rx.size()) return 1;
+    if (fd < 0) return 0;
+    if (!peer_closed) fill(0);
+    return rx_pos < rx.size() || !peer_closed;
+}
+
+int WiFiClient::available(void) {
+    fill(0);
+    return rx.size() - rx_pos;
+}
+
+int WiFiClient::read(void) {
+    if (!fill(1)) return -1;
+    bytes_read++;
+    return rx[rx_pos++];
+}
+
+int WiFiClient::peek(void) {
+    return fill(1) ? rx[rx_pos] : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size) {
+    if (!fill(1)) return -1;
+    size_t n = min(size, rx.size() - rx_pos);
+    memcpy(buffer, rx.data() + rx_pos, n);
+    rx_pos += n;
+    bytes_read += n;
+    return n;
+}
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size) {
+    size_t sent = 0;
+    while (fd >= 0 && sent < size) {
+        ssize_t n = send(fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EAGAIN) {
+            struct pollfd p = {fd, POLLOUT, 0};
+            if (poll(&p, 1, 1000) != 1) break;
+        } else {
+            break;
+        }
+    }
+    return sent;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// HTTPClient
+// ----------------------------------------------------------------------------------------------------------
+static int read_byte(WiFiClient &client) {
+    uint8_t c;
+    return client.readBytes(&c, 1) == 1 ? c : -1;
+}
+
+bool HTTPClient::begin(const String &url) {
+    std::string u = url.c_str();
+    if (u.compare(0, 7, "http://") != 0) return false;
+    u = u.substr(7);
+    size_t slash = u.find('/');
+    std::string authority = u.substr(0, slash);
+    path = slash == std::string::npos ? "/" : u.substr(slash);
+    size_t colon = authority.find(':');
+    host = authority.substr(0, colon);
+    port = colon == std::string::npos ? 80 : atoi(authority.c_str() + colon + 1);
+    size = -1;
+    chunked = false;
+    return !host.empty();
+}
+
+void HTTPClient::addHeader(const String &name, const String &value) {
+    request_headers.push_back({name.c_str(), value.c_str()});
+}
+
+void HTTPClient::collectHeaders(const char *header_keys[], const size_t count) {
+    collected.clear();
+    for (size_t i = 0; i < count; i++) collected.push_back({header_keys[i], ""});
+}
+
+String HTTPClient::header(const char *name) {
+    for (const auto &h : collected) {
+        if (!strcasecmp(h.name.c_str(), name)) return String(h.value.c_str());
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char *name) {
+    return header(name).length() > 0;
+}
+
+int HTTPClient::GET(void) {
+    if (!(reuse && client.connected() && connected_host == host && connected_port == port)) {
+        if (!client.connect(host.c_str(), port, connect_timeout)) return HTTPC_ERROR_CONNECTION_REFUSED;
+        connected_host = host;
+        connected_port = port;
+    }
+    client.setTimeout(timeout);
+    for (auto &h : collected) h.value.clear();
+
+    std::string request = "GET " + path + (http10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    request += "Host: " + host + "\r\nUser-Agent: ESP32HTTPClient\r\n";
+    request += (reuse && !http10) ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    for (const auto &h : request_headers) request += h.name + ": " + h.value + "\r\n";
+    request += "\r\n";
+    request_headers.clear();
+    if (client.write((const uint8_t *)request.data(), request.size()) != request.size()) {
+        client.stop();
+        return HTTPC_ERROR_SEND_HEADER_FAILED;
+    }
+
+    String status = client.readStringUntil('\n');
+    if (status.length() == 0) {
+        client.stop();
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+    int code = 0;
+    if (sscanf(status.c_str(), "HTTP/1.%*d %d", &code) != 1) {
+        client.stop();
+        return HTTPC_ERROR_NO_HTTP_SERVER;
+    }
+    bool server_http10 = status.startsWith("HTTP/1.0");
+
+    size = -1;
+    chunked = false;
+    body_read = false;
+    bool keep_alive = !http10 && !server_http10;
+    while (true) {
+        String line = client.readStringUntil('\n');
+        line.trim();
+        if (line.length() == 0) break;
+        int colon = line.indexOf(':');
+        if (colon < 0) continue;
+        String name = line.substring(0, colon), value = line.substring(colon + 1);
+        value.trim();
+        if (!strcasecmp(name.c_str(), "Content-Length")) size = value.toInt();
+        if (!strcasecmp(name.c_str(), "Transfer-Encoding")) chunked = !strcasecmp(value.c_str(), "chunked");
+        if (!strcasecmp(name.c_str(), "Connection")) {
+            if (!strcasecmp(value.c_str(), "close")) keep_alive = false;
+            if (!strcasecmp(value.c_str(), "keep-alive")) keep_alive = true;
+        }
+        for (auto &h : collected) {
+            if (!strcasecmp(h.name.c_str(), name.c_str())) h.value = value.c_str();
+        }
+    }
+    can_reuse = reuse && keep_alive && (size >= 0 || chunked || code == HTTP_CODE_NOT_MODIFIED);
+    if (code == HTTP_CODE_NOT_MODIFIED || code == 204) size = 0;
+    body_start = client.bytesRead();
+    return code;
+}
+
+String HTTPClient::getString(void) {
+    String body;
+    if (chunked) {
+        while (true) {
+            String line = client.readStringUntil('\n');
+            long length = strtol(line.c_str(), NULL, 16);
+            if (line.length() == 0 || length <= 0) {
+                client.readStringUntil('\n'); // the blank line after the last chunk
+                break;
+            }
+            for (long i = 0; i < length; i++) {
+                int c = read_byte(client);
+                if (c < 0) return body;
+                body += (char)c;
+            }
+            client.readStringUntil('\n');
+        }
+        size = body.length();
+        body_read = true;
+        return body;
+    }
+    if (size > 0) body.reserve(size);
+    while (size < 0 || (int)(client.bytesRead() - body_start) < size) {
+        int c = read_byte(client);
+        if (c < 0) break;
+        body += (char)c;
+    }
+    return body;
+}
+
+void HTTPClient::end(void) {
+    // the rest of a body of known length is read off so the connection can take the next request; a chunked
+    // body only leaves it usable when getString() has read all of it
+    if (can_reuse && chunked && body_read && client.connected()) return;
+    if (can_reuse && !chunked && size >= 0 && client.connected()) {
+        while ((int)(client.bytesRead() - body_start) < size && read_byte(client) >= 0) {
+        }
+        if ((int)(client.bytesRead() - body_start) == size && client.connected()) return;
+    }
+    client.stop();
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+    case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+    case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+    case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+    case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+    case HTTPC_ERROR_NO_STREAM: return "no stream";
+    case HTTPC_ERROR_NO_HTTP_SERVER: return "no HTTP server";
+    case HTTPC_ERROR_TOO_LESS_RAM: return "too less ram";
+    case HTTPC_ERROR_ENCODING: return "Transfer-Encoding not supported";
+    case HTTPC_ERROR_STREAM_WRITE: return "Stream write error";
+    case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+    default: return String();
+    }
+}
@@ -0,0 +1,1662 @@
+#include <Arduino.h>
+
+#include <Adafruit_Protomatter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+#include <ArduinoJson.h>
+#include <GFXcanvas24b.h>
+#include <HTTPClient.h>
+#include <JvdW_RGB565Kernels.h>
+
+#include "bench.h"
+#include "compositor.h"
+#include "frame_scheduler.h"
+#include "lane_strip.h"
+#include "brightness.h"
+#include "subpixel_sprite.h"
+#include "icon_mipmap.h"
+#include "weather_icon.h"
+#include "icon_sheet.h"
+#include "frame_pipeline.h"
+#include "screen_transition.h"
+#include "output_stage.h"
+#include "span_font.h"
+#include "fast_blit.h"
+#include "http_cache.h"
+#include "forecast_ingest.h"
+#include "weather_fetch.h"
+#include "aa_raster.h"
+#include "forecast_panel.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Host benchmark runner for the render path in src/main.cpp.
+//
+//   .pio/build/native/program [--frames N] [--bri 48..256] [--ppm DIR] [--only GROUP] [--server URL]
+//
+// setup() runs against the simulated clock (so the 10 s boot wait is instant), the weather comes from the
+// canned JSON in example_json.h and the icons from data/. Every frame advances the clock by 1/MAX_FPS.
+// The frame pipeline is switched to serial mode without the output stage, so the benchmarks compose straight
+// into the matrix (at full brightness when main.cpp has OUTPUT_STAGE; --bri then only sets the output stage).
+// --server points the network benchmarks at host/tools/weather_server.py (e.g. http://127.0.0.1:8765);
+// without it they only parse the canned responses.
+// ----------------------------------------------------------------------------------------------------------
+extern Adafruit_Protomatter matrix;
+extern GFXcanvas16 *screen;
+extern uint8_t showing_forecast;
+extern LaneStrip_t top_lane, bottom_lane;
+extern BrightnessTable_t *lookup;
+extern SubpixelSprite_t icon_sprite;
+extern IconSheetCache_t icon_sheets;
+extern volatile uint32_t lookup_epoch;
+extern uint16_t lookup_bri;
+extern uint64_t next_swap_time;
+extern ScreenTransition_t screen_transition;
+extern SpanFont_t text_font;
+extern const char *JSON_CURRENT_WEATHER, *JSON_FORECAST_WEATHER;
+
+extern ForecastPanelStats_t forecast_panel_stats;
+
+extern WeatherFetch_t weather_fetch;
+
+void weather_fetch_setup();
+void build_brightness_lookup(uint16_t bri);
+bool swap_brightness_lookup();
+void display_current_weather();
+void display_forecast_weather();
+void draw_forecast_panel(uint8_t);
+void display_scaled_icon(WeatherIcon_t code, int16_t y, GFXcanvas16 *canvas);
+const IconLevel_t *get_icon_at_size(WeatherIcon_t code, uint16_t max_w, uint16_t max_h);
+bool render_icon_frame(WeatherIcon_t code, uint8_t frame, uint8_t frames, uint16_t size, uint16_t *dest);
+void draw_animated_icon(WeatherIcon_t code, uint8_t frame, int16_t x, int16_t y, uint16_t size, GFXcanvas16 *canvas);
+bool DrawWeatherIcon(WeatherIcon_t code, uint16_t *pixels, int16_t w, int16_t h, float t);
+void scale_down(uint16_t *icon_buffer, uint16_t WW, uint16_t W, uint16_t H, uint16_t *bmp, uint8_t scale);
+void update_current_weather();
+void draw_weather_icon(uint8_t);
+void draw_top_lane(uint8_t);
+void draw_bottom_lane(uint8_t);
+void draw_time_colons();
+void track_current_weather();
+void track_forecast_weather();
+void start_screen_transition(TransitionKind kind);
+
+static uint32_t frames = 600;
+static uint16_t brightness = 256;
+static const char *ppm_dir = NULL;
+static const char *server_url = NULL;
+static const char *only_group = NULL;
+static uint32_t checks_run = 0;
+static std::vector<const char *> checks_failed; // by name, once per failed check
+
+const uint32_t HOST_FRAME_US = 1000000L / 45;
+
+bool bench_selected(const char *group) {
+    return only_group == NULL || strcmp(only_group, group) == 0;
+}
+
+void bench_note(const char *name, const char *format, ...) {
+    char buffer[256];
+    va_list arg;
+    va_start(arg, format);
+    vsnprintf(buffer, sizeof(buffer), format, arg);
+    va_end(arg);
+    printf("%-32s %s\n", name, buffer);
+}
+
+const char *bench_check(const char *name, bool ok, const char *pass) {
+    checks_run++;
+    if (ok) return pass;
+    checks_failed.push_back(name);
+    return "NO";
+}
+
+BenchResult_t bench_measure(const char *name, uint32_t iterations, const std::function<void()> &body, double units_per_iter, const char *unit) {
+    std::vector<uint64_t> samples(iterations);
+    HostAllocStats_t before = host_alloc_stats();
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t t0 = host_wall_ns();
+        body();
+        samples[i] = host_wall_ns() - t0;
+    }
+    HostAllocStats_t after = host_alloc_stats();
+
+    double total = 0;
+    for (uint64_t s : samples) total += s;
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult_t r;
+    r.iterations = iterations;
+    r.mean_ns = total / iterations;
+    r.p50_ns = samples[iterations / 2];
+    r.p99_ns = samples[(iterations * 99) / 100];
+    r.min_ns = samples[0];
+    r.allocs_per_iter = (double)(after.allocs - before.allocs) / iterations;
+    r.bytes_per_iter = (double)(after.bytes - before.bytes) / iterations;
+
+    printf("%-32s n=%-6u mean=%10.0fns p50=%10.0fns p99=%10.0fns min=%10.0fns allocs=%6.2f bytes=%8.0f",
+           name, iterations, r.mean_ns, r.p50_ns, r.p99_ns, r.min_ns, r.allocs_per_iter, r.bytes_per_iter);
+    if (units_per_iter > 0 && unit) {
+        printf(" %8.2f %s/us", units_per_iter * 1000.0 / r.mean_ns, unit);
+    }
+    printf("\n");
+    return r;
+}
+
+static void dump_frame(const char *name) {
+    if (!ppm_dir) return;
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.ppm", ppm_dir, name);
+    for (char *p = path + strlen(ppm_dir) + 1; *p; p++) {
+        if (*p == '/') *p = '_';
+    }
+    if (!matrix.savePPM(path)) {
+        fprintf(stderr, "could not write %s\n", path);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Render benchmarks: one screen per case, cleared and redrawn every frame exactly like loop() does
+// ----------------------------------------------------------------------------------------------------------
+static void bench_screen(const char *name, void (*display)(void)) {
+    bench_measure(name, frames, [display]() {
+        host_clock_advance_us(HOST_FRAME_US);
+        matrix.fillScreen(0x0);
+        display();
+        matrix.show();
+    });
+    dump_frame(name);
+}
+
+// Compositor benchmarks: the same screens, redrawing only the damaged elements. The last composed frame
+// must match a full redraw of the same state.
+static void bench_compose(const char *name, void (*track)(void), void (*redraw)(void)) {
+    CompositorStats_t before = compositor_stats();
+    compositor_invalidate_all();
+    bench_measure(name, frames, [track]() {
+        host_clock_advance_us(HOST_FRAME_US);
+        compositor_begin_frame();
+        track();
+        if (compositor_end_frame(&matrix)) {
+            matrix.show();
+        }
+    });
+    const CompositorStats_t &after = compositor_stats();
+    bench_note(name, "skipped %u/%u frames, %.2f element redraws/frame, %.0f px cleared/frame, %.0f px blended/frame",
+               after.frames_skipped - before.frames_skipped, after.frames - before.frames,
+               (double)(after.elements_drawn - before.elements_drawn) / frames,
+               (double)(after.pixels_cleared - before.pixels_cleared) / frames,
+               (double)(after.pixels_blended - before.pixels_blended) / frames);
+    dump_frame(name);
+
+    size_t bytes = matrix.width() * matrix.height() * sizeof(uint16_t);
+    std::vector<uint16_t> composed(matrix.getBuffer(), matrix.getBuffer() + bytes / 2);
+    matrix.fillScreen(0x0);
+    redraw();
+    bench_note(name, "matches full redraw: %s", bench_check(name, !memcmp(composed.data(), matrix.getBuffer(), bytes)));
+    compositor_invalidate_all();
+}
+
+static void track_current_screen(void) {
+    update_current_weather();
+    track_current_weather();
+}
+
+static void redraw_current_screen(void) {
+    draw_weather_icon(0);
+    draw_top_lane(0);
+    draw_bottom_lane(0);
+    draw_time_colons();
+}
+
+// A translucent badge layer sliding over the current weather screen: only the area it leaves and enters is
+// blended again, from the cached layers under it
+static const uint8_t OVERLAY_ID = COMPOSITOR_MAX_ELEMENTS - 1;
+static uint16_t overlay_pixels[24 * 12];
+static CompositorLayer_t overlay_layer = {overlay_pixels, NULL, 0, 26, 24, 12, 24, 160, BlendOpaque, true};
+
+static void track_current_screen_overlay(void) {
+    track_current_screen();
+    overlay_layer.x = (overlay_layer.x + 1) % (matrix.width() - overlay_layer.w);
+    compositor_track_layer(OVERLAY_ID, &overlay_layer);
+}
+
+static void redraw_current_screen_overlay(void) {
+    redraw_current_screen();
+    for (int16_t y = 0; y < overlay_layer.h; y++) {
+        uint16_t *row = matrix.getBuffer() + (overlay_layer.y + y) * matrix.width() + overlay_layer.x;
+        RGB565_REFERENCE.blend(overlay_pixels + y * overlay_layer.w, row, row, overlay_layer.w, overlay_layer.opacity);
+    }
+}
+
+// Forecast panel: the whole screen from the cache, against rendering the six rows
+static void bench_forecast_panel(void) {
+    ForecastPanelStats_t before = forecast_panel_stats;
+    bench_measure("render/forecast_panel", frames, []() {
+        host_clock_advance_us(HOST_FRAME_US);
+        matrix.fillScreen(0x0);
+        draw_forecast_panel(0);
+        matrix.show();
+    });
+    bench_note("render/forecast_panel", "hits=%u misses=%u", forecast_panel_stats.hits - before.hits, forecast_panel_stats.misses - before.misses);
+}
+
+static void bench_render(void) {
+    if (!bench_selected("render")) return;
+    bench_screen("render/forecast", display_forecast_weather);
+    bench_screen("render/current", display_current_weather);
+    bench_forecast_panel();
+    bench_compose("compose/forecast", track_forecast_weather, display_forecast_weather);
+    bench_compose("compose/current", track_current_screen, redraw_current_screen);
+    for (uint16_t i = 0; i < 24 * 12; i++) overlay_pixels[i] = (i / 24 + i) & 1 ? 0x07FF : 0xF81F;
+    bench_compose("compose/overlay", track_current_screen_overlay, redraw_current_screen_overlay);
+    bench_measure("render/loop", frames, []() {
+        host_clock_advance_us(HOST_FRAME_US);
+        loop();
+    });
+    while (screen != &matrix) { // let a screen transition finish, the other benchmarks draw on the matrix
+        host_clock_advance_us(HOST_FRAME_US);
+        loop();
+    }
+    dump_frame("loop");
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Lanes: both lanes drawn from the cached strips, against re-rendering every segment each frame as they
+// used to be. The cached frame must match a freshly rendered one, and the circular blit drawRGBBitmap.
+// ----------------------------------------------------------------------------------------------------------
+static void draw_lanes(void) {
+    host_clock_advance_us(HOST_FRAME_US);
+    update_current_weather();
+    draw_top_lane(0);
+    draw_bottom_lane(0);
+}
+
+static void bench_lanes(void) {
+    if (!bench_selected("lanes")) return;
+    LaneStripStats_t top_before = top_lane.stats, bottom_before = bottom_lane.stats;
+    bench_measure("lanes/cached", frames, draw_lanes);
+    bench_note("lanes/cached", "segment renders top=%u bottom=%u, segment dims=%u, full dims=%u",
+               top_lane.stats.segment_renders - top_before.segment_renders,
+               bottom_lane.stats.segment_renders - bottom_before.segment_renders,
+               top_lane.stats.segment_dims - top_before.segment_dims + bottom_lane.stats.segment_dims - bottom_before.segment_dims,
+               top_lane.stats.full_dims - top_before.full_dims + bottom_lane.stats.full_dims - bottom_before.full_dims);
+
+    bench_measure("lanes/rerender", frames, []() {
+        lane_strip_invalidate(&top_lane);
+        lane_strip_invalidate(&bottom_lane);
+        draw_lanes();
+    });
+
+    size_t bytes = matrix.width() * matrix.height() * sizeof(uint16_t);
+    draw_top_lane(0);
+    draw_bottom_lane(0);
+    std::vector<uint16_t> cached(matrix.getBuffer(), matrix.getBuffer() + bytes / 2);
+    lane_strip_invalidate(&top_lane);
+    lane_strip_invalidate(&bottom_lane);
+    draw_top_lane(0);
+    draw_bottom_lane(0);
+    bench_note("lanes/cached", "matches re-render: %s", bench_check("lanes/cached", !memcmp(cached.data(), matrix.getBuffer(), bytes)));
+
+    // Blitting alone, per lane, at every scroll position: the circular copy against clipping the whole
+    // strip with drawRGBBitmap (twice near the wrap point) as it used to be
+    const LaneStrip_t *lanes[] = {&top_lane, &bottom_lane};
+    const char *names[] = {"top", "bottom"};
+    for (uint8_t l = 0; l < 2; l++) {
+        const LaneStrip_t *lane = lanes[l];
+        int16_t W = lane->canvas->width(), H = lane->canvas->height(), SW = matrix.width();
+        auto blit_gfx = [lane, W, H, SW](int16_t left_x) {
+            matrix.drawRGBBitmap(-left_x, 0, lane->pixels, W, H);
+            if (left_x >= W - SW) matrix.drawRGBBitmap(W - left_x, 0, lane->pixels, W, H);
+        };
+        char name[48];
+        int16_t left_x = 0;
+        snprintf(name, sizeof(name), "lanes/blit_%s_gfx", names[l]);
+        bench_measure(name, frames, [&]() {
+            blit_gfx(left_x);
+            left_x = (left_x + 1) % W;
+        }, SW * H, "px");
+        snprintf(name, sizeof(name), "lanes/blit_%s_ring", names[l]);
+        bench_measure(name, frames, [&]() {
+            lane_strip_blit(lane, left_x, &matrix, 0);
+            left_x = (left_x + 1) % W;
+        }, SW * H, "px");
+
+        uint32_t mismatches = 0;
+        size_t lane_bytes = SW * H * sizeof(uint16_t);
+        for (left_x = 0; left_x < W; left_x++) {
+            blit_gfx(left_x);
+            std::vector<uint16_t> gfx(matrix.getBuffer(), matrix.getBuffer() + lane_bytes / 2);
+            lane_strip_blit(lane, left_x, &matrix, 0);
+            mismatches += memcmp(gfx.data(), matrix.getBuffer(), lane_bytes) != 0;
+        }
+        bench_note(name, "%d wide, %u/%d scroll positions differ from drawRGBBitmap", W, mismatches, W);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Text: the lane and forecast strings drawn with the span font against the GFX print path, and every glyph
+// of the font compared between the two, on the canvas and clipped at each of its edges
+// ----------------------------------------------------------------------------------------------------------
+static void bench_text(void) {
+    if (!bench_selected("text")) return;
+    const char *lines[] = {"21.5\xF8" "C", "13 km/h", "55%", "12 34", "Langwarrin", " 9", "17"};
+    const uint8_t line_count = sizeof(lines) / sizeof(lines[0]);
+    uint32_t glyphs = 0;
+    for (uint8_t i = 0; i < line_count; i++) glyphs += strlen(lines[i]);
+
+    GFXcanvas16 gfx(192, 16), span(192, 16);
+    gfx.setTextWrap(false);
+    gfx.cp437(true); // as top_canvas and bottom_canvas
+    bench_measure("text/gfx_print", frames, [&]() {
+        for (uint8_t i = 0; i < line_count; i++) {
+            gfx.setCursor(i * 4, i & 7);
+            gfx.setTextColor(0xFFE0 - i);
+            gfx.print(lines[i]);
+        }
+    }, glyphs, "glyph");
+    bench_measure("text/span", frames, [&]() {
+        for (uint8_t i = 0; i < line_count; i++) {
+            span_text_draw(&text_font, &span, i * 4, i & 7, lines[i], 0xFFE0 - i);
+        }
+    }, glyphs, "glyph");
+    size_t bytes = 192 * 16 * sizeof(uint16_t);
+    bench_note("text/span", "matches gfx: %s", bench_check("text/span", !memcmp(gfx.getBuffer(), span.getBuffer(), bytes)));
+
+    const int16_t positions[][2] = {{10, 4}, {-3, 4}, {-5, 4}, {188, 4}, {190, 4}, {10, -3}, {10, -7}, {10, 12}, {10, 15}};
+    uint32_t checked = 0, mismatched = 0;
+    for (const uint8_t *c = (const uint8_t *)SPAN_FONT_DEFAULT_CHARS; *c; c++) {
+        char text[2] = {(char)*c, 0};
+        for (const auto &at : positions) {
+            gfx.fillScreen(0);
+            span.fillScreen(0);
+            gfx.setCursor(at[0], at[1]);
+            gfx.setTextColor(0x07FF);
+            gfx.print(text);
+            int16_t end_x = span_text_draw(&text_font, &span, at[0], at[1], text, 0x07FF);
+            checked++;
+            if (memcmp(gfx.getBuffer(), span.getBuffer(), bytes) || end_x != gfx.getCursorX()) mismatched++;
+        }
+    }
+    bench_note("text/span", "%u glyphs in %u spans; %u placements checked, %u mismatched: %s", text_font.glyph_count,
+               text_font.span_count, checked, mismatched, bench_check("text/span", mismatched == 0));
+
+    // the degree sign is code page 437's 0xF8, which the GFX font has at 0xF8 only with cp437 on
+    GFXcanvas1 degree(6, 8);
+    degree.cp437(true);
+    degree.drawChar(0, 0, 0xF8, 1, 1, 1, 1);
+    span.fillScreen(0);
+    span_text_draw(&text_font, &span, 0, 0, "\xF8", 1);
+    uint32_t wrong = 0;
+    for (int16_t y = 0; y < 8; y++) {
+        for (int16_t x = 0; x < 6; x++) wrong += !degree.getPixel(x, y) != !span.getPixel(x, y);
+    }
+    bench_note("text/span", "degree sign is cp437 0xF8: %s", bench_check("text/span", wrong == 0));
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Blit: row copies into the matrix against drawRGBBitmap, for a full-screen surface and an icon-sized
+// sprite, and the keyed copy against drawing the non-key pixels one by one; then both compared with the
+// GFX calls at positions clipped on every side
+// ----------------------------------------------------------------------------------------------------------
+static void bench_blit(void) {
+    if (!bench_selected("blit")) return;
+    const int16_t SW = matrix.width(), SH = matrix.height(), S = 32;
+    std::vector<uint16_t> panel(SW * SH), sprite(S * S);
+    for (int16_t i = 0; i < SW * SH; i++) panel[i] = (uint16_t)(i * 2654435761u >> 16);
+    for (int16_t y = 0; y < S; y++) {
+        for (int16_t x = 0; x < S; x++) {
+            int16_t dx = x - S / 2, dy = y - S / 2;
+            sprite[y * S + x] = dx * dx + dy * dy < S * S / 5 ? (uint16_t)(0x0821 * (x + y) | 1) : 0; // 0: key
+        }
+    }
+    auto draw_keyed_gfx = [&](GFXcanvas16 *dest, int16_t x0, int16_t y0) {
+        for (int16_t y = 0; y < S; y++) {
+            for (int16_t x = 0; x < S; x++) {
+                if (sprite[y * S + x]) dest->drawPixel(x0 + x, y0 + y, sprite[y * S + x]);
+            }
+        }
+    };
+
+    bench_measure("blit/panel_gfx", frames, [&]() { matrix.drawRGBBitmap(0, 0, panel.data(), SW, SH); }, SW * SH, "px");
+    bench_measure("blit/panel_rows", frames, [&]() { blit_rgb565(&matrix, 0, 0, panel.data(), SW, SH); }, SW * SH, "px");
+    bench_measure("blit/sprite_gfx", frames, [&]() { matrix.drawRGBBitmap(16, 16, sprite.data(), S, S); }, S * S, "px");
+    bench_measure("blit/sprite_rows", frames, [&]() { blit_rgb565(&matrix, 16, 16, sprite.data(), S, S); }, S * S, "px");
+    bench_measure("blit/keyed_gfx", frames, [&]() { draw_keyed_gfx(&matrix, 16, 16); }, S * S, "px");
+    bench_measure("blit/keyed_runs", frames, [&]() { blit_rgb565_keyed(&matrix, 16, 16, sprite.data(), S, S, S, 0); },
+                  S * S, "px");
+
+    GFXcanvas16 gfx(SW, SH), rows(SW, SH);
+    size_t bytes = SW * SH * sizeof(uint16_t);
+    uint32_t checked = 0, mismatched = 0;
+    for (int16_t y = -S - 1; y <= SH + 1; y += 5) {
+        for (int16_t x = -S - 1; x <= SW + 1; x += 5) {
+            memcpy(gfx.getBuffer(), panel.data(), bytes);
+            memcpy(rows.getBuffer(), panel.data(), bytes);
+            gfx.drawRGBBitmap(x, y, sprite.data(), S, S);
+            blit_rgb565(&rows, x, y, sprite.data(), S, S);
+            draw_keyed_gfx(&gfx, y, x);
+            blit_rgb565_keyed(&rows, y, x, sprite.data(), S, S, S, 0);
+            checked++;
+            if (memcmp(gfx.getBuffer(), rows.getBuffer(), bytes)) mismatched++;
+        }
+    }
+    bench_note("blit/sprite_rows", "%u clipped placements checked (plain and keyed), %u mismatched: %s", checked, mismatched,
+               bench_check("blit/sprite_rows", mismatched == 0));
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Icon: blitting the pre-rendered sub-pixel phases against blending the icon every frame
+// ----------------------------------------------------------------------------------------------------------
+static void bench_icon(void) {
+    if (!bench_selected("icon")) return;
+    uint32_t renders_before = icon_sprite.phase_renders;
+    bench_measure("icon/phases", frames, []() {
+        update_current_weather();
+        draw_weather_icon(0);
+    });
+    bench_note("icon/phases", "%u phases of %ux%u, %u bytes, %u phase renders",
+               icon_sprite.phases, icon_sprite.w, icon_sprite.h, (unsigned)(icon_sprite.capacity * sizeof(uint16_t)),
+               icon_sprite.phase_renders - renders_before);
+
+    // a forecast row icon from the pyramid, against resampling the full-size icon as the rows used to
+    const IconLevel_t *full = get_icon_at_size(IconRain, 0xFFFF, 0xFFFF), *small = get_icon_at_size(IconRain, 16, 11);
+    if (full && small) {
+        std::vector<uint16_t> resampled(small->w * small->h), dimmed(small->w * small->h);
+        bench_measure("icon/forecast_mipmap", frames, []() { display_scaled_icon(IconRain, 20, &matrix); });
+        bench_measure("icon/forecast_resample", frames, [&]() {
+            scale_down((uint16_t *)full->pixels, full->w, small->w, small->h, resampled.data(), full->w / small->w);
+            matrix.drawRGBBitmap(14, 18, resampled.data(), small->w, small->h);
+        });
+        brightness_scale_buffer(lookup, small->pixels, dimmed.data(), small->w * small->h);
+        bench_note("icon/forecast_mipmap", "%ux%u level of %ux%u, matches resampling: %s", small->w, small->h, full->w, full->h,
+                   bench_check("icon/forecast_mipmap", !memcmp(dimmed.data(), resampled.data(), dimmed.size() * 2)));
+    }
+
+    std::vector<uint16_t> temp(icon_sprite.w * icon_sprite.h);
+    uint8_t phase = 0;
+    bench_measure("icon/blend_every_frame", frames, [&]() {
+        update_current_weather();
+        subpixel_sprite_render(&icon_sprite, phase++ % icon_sprite.phases, lookup, temp.data());
+        matrix.drawRGBBitmap(0, 14, temp.data(), icon_sprite.w, icon_sprite.h);
+    });
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Icon sheets: the first loop of every icon's animation (frames drawn into the cache), the loops after it
+// (lookup and blit), and drawing the sun procedurally every frame as the icon test used to. Then a cap of
+// three sheets, cycling through every icon, to exercise the LRU eviction.
+// ----------------------------------------------------------------------------------------------------------
+static void bench_sheet(void) {
+    if (!bench_selected("sheet")) return;
+    const uint16_t SIZE = 32, STEPS = icon_sheets.frames;
+    icon_sheet_clear(&icon_sheets);
+    icon_sheets.stats = {};
+
+    uint32_t n = 0;
+    bench_measure("sheet/first_loop", WEATHER_ICON_KINDS * 2 * STEPS, [&]() {
+        WeatherIcon_t code = (n / STEPS) / 2 | ((n / STEPS) & 1 ? WEATHER_ICON_NIGHT : 0);
+        draw_animated_icon(code, n++ % STEPS, 0, 16, SIZE, &matrix);
+    });
+    bench_note("sheet/first_loop", "%u frame renders, %u sheets, %u bytes, %u failures", icon_sheets.stats.frame_renders,
+               icon_sheets.stats.sheet_allocs, (unsigned)icon_sheets.bytes, icon_sheets.stats.failures);
+
+    for (uint16_t i = 0; i < STEPS; i++) draw_animated_icon(IconClearSky, i, 0, 16, SIZE, &matrix);
+    uint32_t hits_before = icon_sheets.stats.hits, renders_before = icon_sheets.stats.frame_renders;
+    n = 0;
+    bench_measure("sheet/hit", frames, [&]() { draw_animated_icon(IconClearSky, n++ % STEPS, 0, 16, SIZE, &matrix); });
+    bench_note("sheet/hit", "%u hits, %u frame renders", icon_sheets.stats.hits - hits_before, icon_sheets.stats.frame_renders - renders_before);
+
+    std::vector<uint16_t> bmp(SIZE * SIZE);
+    n = 0;
+    bench_measure("sheet/draw_every_frame", frames, [&]() {
+        DrawWeatherIcon(IconClearSky, bmp.data(), SIZE, SIZE, (float)(n++ % STEPS) / (STEPS * 8));
+        brightness_scale_buffer(lookup, bmp.data(), bmp.data(), SIZE * SIZE);
+        matrix.drawRGBBitmap(0, 16, bmp.data(), SIZE, SIZE);
+    });
+
+    uint32_t mismatches = 0;
+    for (uint8_t kind = 0; kind < WEATHER_ICON_KINDS; kind++) {
+        for (uint8_t frame = 0; frame < STEPS; frame++) {
+            const uint16_t *cached = icon_sheet_frame(&icon_sheets, kind, SIZE, frame, lookup, lookup_epoch);
+            if (cached == NULL || !render_icon_frame(kind, frame, STEPS, SIZE, bmp.data())) {
+                mismatches++;
+                continue;
+            }
+            brightness_scale_buffer(lookup, bmp.data(), bmp.data(), SIZE * SIZE);
+            if (memcmp(cached, bmp.data(), bmp.size() * sizeof(uint16_t))) mismatches++;
+        }
+    }
+    bench_note("sheet/hit", "%u frames not matching a fresh render", mismatches);
+
+    size_t cap = icon_sheets.cap_bytes;
+    icon_sheet_clear(&icon_sheets);
+    icon_sheets.cap_bytes = 3 * STEPS * SIZE * SIZE * sizeof(uint16_t);
+    icon_sheets.stats = {};
+    n = 0;
+    bench_measure("sheet/lru", frames, [&]() { draw_animated_icon((n / STEPS) % WEATHER_ICON_KINDS, n % STEPS, 0, 16, SIZE, &matrix), n++; });
+    bench_note("sheet/lru", "cap %u bytes: %u sheets, %u evicted, %u bytes in use", (unsigned)icon_sheets.cap_bytes,
+               icon_sheets.stats.sheet_allocs, icon_sheets.stats.evictions, (unsigned)icon_sheets.bytes);
+    icon_sheet_clear(&icon_sheets);
+    icon_sheets.cap_bytes = cap;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Raster: the sun drawn straight at 32x32 with the anti-aliased primitives, against the way it used to be
+// drawn: with GFX lines and circles on a 64x64 canvas, box-filtered down by 2. The two should look the
+// same, so the per-channel error (in 8-bit steps) has to stay within a tolerance.
+// ----------------------------------------------------------------------------------------------------------
+static void supersampled_sun(GFXcanvas16 *canvas, float t) {
+    const uint16_t colour = 0xFF6F; // colour_565_sun
+    int16_t cx = canvas->width() >> 1, cy = canvas->height() >> 1;
+    int16_t r_outer = min(canvas->width(), canvas->height()) / 2, r_inner = r_outer / 2, r_mid = r_inner + 4;
+    canvas->fillScreen(0);
+    canvas->drawCircle(cx, cy, r_inner, colour);
+    canvas->drawCircle(cx, cy, r_inner - 1, colour);
+    t *= M_PI * 2.0f;
+    for (uint8_t a = 0; a < 8; a++) {
+        float tt = t;
+        for (uint8_t v = 0; v < 2; v++) {
+            float c = cosf(tt), s = sinf(tt);
+            canvas->drawLine(cx + (int16_t)(c * r_mid), cy + (int16_t)(s * r_mid), cx + (int16_t)(c * r_outer), cy + (int16_t)(s * r_outer), colour);
+            tt += (2.0f * M_PI / 100.0f);
+        }
+        t += (2.0f * M_PI / 8.0f);
+    }
+}
+
+static void bench_raster(void) {
+    if (!bench_selected("raster")) return;
+    const uint16_t SIZE = 32, STEPS = 16;
+    GFXcanvas16 canvas(2 * SIZE, 2 * SIZE);
+    std::vector<uint16_t> direct(SIZE * SIZE), reference(SIZE * SIZE);
+
+    uint32_t n = 0;
+    bench_measure("raster/aa_direct", frames, [&]() { DrawWeatherIcon(IconClearSky, direct.data(), SIZE, SIZE, (float)(n++ % STEPS) / (STEPS * 8)); });
+    n = 0;
+    bench_measure("raster/supersample", frames, [&]() {
+        supersampled_sun(&canvas, (float)(n++ % STEPS) / (STEPS * 8));
+        RGB565.downscale(canvas.getBuffer(), 2 * SIZE, reference.data(), SIZE, SIZE, 2);
+    });
+    bench_note("raster/aa_direct", "%u bytes drawn into, against %u", (unsigned)(SIZE * SIZE * 2), (unsigned)(4 * SIZE * SIZE * 2));
+
+    // 8-bit error of every channel of the pixels lit in either image, over a loop of the animation. The two
+    // rasterise the rays slightly apart, which leaves 49.31 here; coverage that is ignored, inverted or
+    // doubled makes it 70 or more, and coverage that is scaled down shows in the ink.
+    const uint32_t MEAN_TOLERANCE_X100 = 5100, INK_TOLERANCE_PERCENT = 8;
+    uint64_t error = 0, ink_direct = 0, ink_reference = 0;
+    uint32_t samples = 0, worst = 0;
+    for (uint16_t step = 0; step < STEPS; step++) {
+        float t = (float)step / (STEPS * 8);
+        DrawWeatherIcon(IconClearSky, direct.data(), SIZE, SIZE, t);
+        supersampled_sun(&canvas, t);
+        RGB565.downscale(canvas.getBuffer(), 2 * SIZE, reference.data(), SIZE, SIZE, 2);
+        for (uint32_t i = 0; i < direct.size(); i++) {
+            uint16_t a = direct[i], b = reference[i];
+            if (a == 0 && b == 0) continue; // background in both: would only water the mean down
+            int32_t channels[3][2] = {{(a >> 11) << 3, (b >> 11) << 3}, {((a >> 5) & 0x3F) << 2, ((b >> 5) & 0x3F) << 2}, {(a & 0x1F) << 3, (b & 0x1F) << 3}};
+            for (auto &c : channels) {
+                uint32_t e = abs(c[0] - c[1]);
+                error += e;
+                worst = std::max(worst, e);
+                ink_direct += c[0];
+                ink_reference += c[1];
+                samples++;
+            }
+        }
+    }
+    uint32_t mean_x100 = error * 100 / samples;
+    uint32_t ink_percent = ink_reference ? ink_direct * 100 / ink_reference : 0;
+    bench_note("raster/aa_direct", "vs supersampled: mean error %u.%02u, worst %u, ink %u%%, within tolerance: %s", mean_x100 / 100, mean_x100 % 100,
+               worst, ink_percent, bench_check("raster/aa_direct", mean_x100 <= MEAN_TOLERANCE_X100 && abs((int32_t)ink_percent - 100) <= (int32_t)INK_TOLERANCE_PERCENT));
+    if (ppm_dir) {
+        matrix.fillScreen(0);
+        matrix.drawRGBBitmap(0, 0, direct.data(), SIZE, SIZE);
+        matrix.drawRGBBitmap(SIZE, 0, reference.data(), SIZE, SIZE);
+        dump_frame("raster/aa_vs_supersampled");
+    }
+
+    // Coverage on its own: white rings at fractional positions against the share of 16x16 samples of each
+    // pixel that fall inside the ring. Pixels whose 3x3 neighbourhood is all inside or all outside must come
+    // out exact; on the edge pixels (partly covered in either), where coverage is estimated from the distance
+    // of the pixel's centre, the estimate has to stay close to the area.
+    const uint32_t EDGE_MEAN_TOLERANCE_X100 = 450, EDGE_WORST_TOLERANCE = 20, INTERIOR_WORST_TOLERANCE = 0;
+    const int16_t SUB = 16;
+    std::vector<uint16_t> ring(SIZE * SIZE);
+    std::vector<uint8_t> area(SIZE * SIZE);
+    AASurface_t surface = {ring.data(), (int16_t)SIZE, (int16_t)SIZE};
+    uint64_t edge_error = 0;
+    uint32_t edge_pixels = 0, edge_worst = 0, interior_pixels = 0, interior_worst = 0;
+    for (uint16_t step = 0; step < STEPS; step++) {
+        int32_t cx = AA_ONE * 15 + step * 37 % AA_ONE, cy = AA_ONE * 16 - step * 59 % AA_ONE;
+        int32_t radius = AA_ONE * 9 + step * 23 % AA_ONE, thickness = AA_ONE * 5 + step * 41 % AA_ONE;
+        float outer = (radius + thickness / 2) / (float)AA_ONE, inner = (radius - thickness / 2) / (float)AA_ONE;
+        std::fill(ring.begin(), ring.end(), 0);
+        aa_circle(&surface, cx, cy, radius, thickness, 0xFFFF);
+        for (int16_t y = 0; y < SIZE; y++) {
+            for (int16_t x = 0; x < SIZE; x++) {
+                uint32_t inside = 0;
+                for (int16_t sy = 0; sy < SUB; sy++) {
+                    for (int16_t sx = 0; sx < SUB; sx++) {
+                        float dx = x - 0.5f + (sx + 0.5f) / SUB - cx / (float)AA_ONE;
+                        float dy = y - 0.5f + (sy + 0.5f) / SUB - cy / (float)AA_ONE;
+                        float d = sqrtf(dx * dx + dy * dy);
+                        inside += d >= inner && d < outer;
+                    }
+                }
+                area[y * SIZE + x] = inside * 255 / (SUB * SUB);
+            }
+        }
+        for (int16_t y = 1; y < SIZE - 1; y++) {
+            for (int16_t x = 1; x < SIZE - 1; x++) {
+                uint8_t lowest = 255, highest = 0;
+                for (int16_t ny = y - 1; ny <= y + 1; ny++) {
+                    for (int16_t nx = x - 1; nx <= x + 1; nx++) {
+                        lowest = min(lowest, area[ny * SIZE + nx]);
+                        highest = max(highest, area[ny * SIZE + nx]);
+                    }
+                }
+                int32_t drawn = ((ring[y * SIZE + x] >> 5) & 0x3F) * 255 / 63, exact = area[y * SIZE + x];
+                uint32_t e = abs(drawn - exact);
+                if (highest == 0 || lowest == 255) {
+                    interior_pixels++;
+                    interior_worst = max(interior_worst, e);
+                } else if ((drawn > 0 && drawn < 255) || (exact > 0 && exact < 255)) { // partly covered in either
+                    edge_pixels++;
+                    edge_error += e;
+                    edge_worst = max(edge_worst, e);
+                }
+            }
+        }
+    }
+    uint32_t edge_mean_x100 = edge_error * 100 / max(1u, edge_pixels);
+    bench_note("raster/aa_coverage", "%u edge pixels: mean error %u.%02u, worst %u; %u interior, worst %u: %s", edge_pixels,
+               edge_mean_x100 / 100, edge_mean_x100 % 100, edge_worst, interior_pixels, interior_worst,
+               bench_check("raster/aa_coverage", edge_mean_x100 <= EDGE_MEAN_TOLERANCE_X100 && edge_worst <= EDGE_WORST_TOLERANCE &&
+                                                     interior_worst <= INTERIOR_WORST_TOLERANCE));
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Brightness lookup: a full rebuild of the back table, and the cost of swapping it in between frames
+// ----------------------------------------------------------------------------------------------------------
+static void bench_lookup(void) {
+    if (!bench_selected("lookup")) return;
+    bench_measure("lookup/build", 50, []() {
+        build_brightness_lookup(brightness);
+        swap_brightness_lookup();
+    });
+    bench_measure("lookup/swap_idle", 10000, []() { swap_brightness_lookup(); });
+
+    // the brightness in use must not change until the new table (or output stage) is swapped in
+    uint16_t before = lookup_bri;
+    build_brightness_lookup(brightness == 256 ? 128 : 256);
+    bool untouched = lookup_bri == before;
+    swap_brightness_lookup();
+    bool swapped = lookup_bri != before;
+    build_brightness_lookup(brightness);
+    swap_brightness_lookup();
+    bench_note("lookup/build", "front table untouched until swap: %s, swapped: %s", bench_check("lookup/build", untouched), bench_check("lookup/build", swapped));
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Brightness scaling: the per-channel tables and the two-pixels-per-word kernel against the full 64K table
+// they replace, on a 64x64 screen of random colours. Both must match the table for every colour at every
+// brightness the light sensor can produce.
+// ----------------------------------------------------------------------------------------------------------
+static void build_full_table(uint16_t *table, uint16_t bri) {
+    uint16_t i = 0;
+    for (uint16_t r = 0; r < 32; r++) {
+        for (uint16_t g = 0; g < 64; g++) {
+            for (uint16_t b = 0; b < 32; b++) {
+                uint16_t rr = (r * bri) >> 8, gg = (g * bri) >> 8, bb = (b * bri) >> 8;
+                table[i++] = (rr << 11) | (gg << 5) | bb;
+            }
+        }
+    }
+}
+
+static void bench_brightness(void) {
+    if (!bench_selected("brightness")) return;
+    std::vector<uint16_t> full(65536), colours(65536), scaled(65536);
+    BrightnessTable_t table;
+
+    uint32_t mismatches = 0;
+    for (uint16_t bri = 48; bri <= 256; bri++) {
+        build_full_table(full.data(), bri);
+        brightness_build(&table, bri);
+        for (uint32_t c = 0; c < 65536; c++) {
+            colours[c] = c;
+            mismatches += brightness_scale(&table, c) != full[c];
+        }
+        // aligned, both buffers off by one pixel, and off from each other
+        brightness_scale_buffer(&table, colours.data(), scaled.data(), 65536);
+        for (uint32_t c = 0; c < 65536; c++) mismatches += scaled[c] != full[c];
+        brightness_scale_buffer(&table, colours.data() + 1, scaled.data() + 1, 65535);
+        for (uint32_t c = 1; c < 65536; c++) mismatches += scaled[c] != full[c];
+        brightness_scale_buffer(&table, colours.data() + 1, scaled.data(), 65535);
+        for (uint32_t c = 0; c < 65535; c++) mismatches += scaled[c] != full[c + 1];
+    }
+    bench_note("brightness/exact", "%u mismatches against the 64K table over bri 48..256", mismatches);
+
+    const uint32_t N = 64 * 64;
+    std::vector<uint16_t> source(N), dest(N);
+    for (uint32_t i = 0; i < N; i++) source[i] = esp_random();
+    build_full_table(full.data(), brightness);
+    brightness_build(&table, brightness);
+    bench_measure("brightness/table64k", frames, [&]() {
+        for (uint32_t i = 0; i < N; i++) dest[i] = full[source[i]];
+    }, N, "px");
+    bench_measure("brightness/channels", frames, [&]() {
+        for (uint32_t i = 0; i < N; i++) dest[i] = brightness_scale(&table, source[i]);
+    }, N, "px");
+    bench_measure("brightness/bulk", frames, [&]() {
+        brightness_scale_buffer(&table, source.data(), dest.data(), N);
+    }, N, "px");
+    bench_note("brightness/bulk", "table size %u bytes (was %u)", (unsigned)sizeof(BrightnessTable_t), 65536 * 2);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// RGB565 kernels: every backend against the reference (all alignments, odd lengths, every weight and
+// brightness, every scale), and the reference blend against the 7-bit icon blend it replaced. Then pixels
+// per microsecond for each kernel and backend on a 64x64 screen.
+// ----------------------------------------------------------------------------------------------------------
+static void bench_kernels(void) {
+    if (!bench_selected("kernels")) return;
+    std::vector<const RGB565Kernels_t *> backends = {&RGB565_REFERENCE, &RGB565_SWAR};
+#if RGB565_HAS_PIE
+    backends.push_back(&RGB565_PIE);
+#endif
+    const uint32_t N = 64 * 64;
+    std::vector<uint16_t> a(N + 8), b(N + 8), expected(N + 8), actual(N + 8);
+    for (uint32_t i = 0; i < N + 8; i++) {
+        a[i] = esp_random();
+        b[i] = esp_random();
+    }
+
+    uint32_t mismatches = 0;
+    for (uint16_t k0 = 0; k0 < 128; k0++) {
+        RGB565_REFERENCE.blend(a.data(), b.data(), expected.data(), N, k0 * 2);
+        for (uint32_t i = 0; i < N; i++) {
+            uint16_t c0 = a[i], c1 = b[i], k1 = 128 - k0;
+            uint16_t r = ((c0 >> 11) * k0 + (c1 >> 11) * k1) >> 7;
+            uint16_t g = (((c0 >> 5) & 0x3F) * k0 + ((c1 >> 5) & 0x3F) * k1) >> 7;
+            uint16_t bb = ((c0 & 0x1F) * k0 + (c1 & 0x1F) * k1) >> 7;
+            mismatches += expected[i] != ((r << 11) | (g << 5) | bb);
+        }
+    }
+    bench_note("kernels/exact", "reference blend vs icon blend: %u mismatches", mismatches);
+
+    for (const RGB565Kernels_t *k : backends) {
+        mismatches = 0;
+        for (uint16_t bri = 0; bri <= 256; bri++) {
+            uint32_t offset = bri % 8, length = N - (bri % 13);
+            RGB565_REFERENCE.dim(a.data() + offset, expected.data(), length, bri);
+            k->dim(a.data() + offset, actual.data() + (bri % 3), length, bri);
+            mismatches += memcmp(expected.data(), actual.data() + (bri % 3), length * 2) != 0;
+        }
+        for (uint16_t weight = 0; weight <= 256; weight++) {
+            uint32_t length = N - (weight % 7);
+            RGB565_REFERENCE.blend(a.data() + (weight % 5), a.data() + (weight % 5) + 1, expected.data(), length, weight);
+            k->blend(a.data() + (weight % 5), a.data() + (weight % 5) + 1, actual.data() + (weight % 2), length, weight);
+            mismatches += memcmp(expected.data(), actual.data() + (weight % 2), length * 2) != 0;
+        }
+        for (uint8_t scale = 1; scale <= 8; scale++) {
+            uint16_t w = 64 / scale, h = 64 / scale;
+            RGB565_REFERENCE.downscale(a.data(), 64, expected.data(), w, h, scale);
+            k->downscale(a.data(), 64, actual.data(), w, h, scale);
+            mismatches += memcmp(expected.data(), actual.data(), w * h * 2) != 0;
+        }
+        bench_note("kernels/exact", "%s vs reference: %u mismatching runs", k->name, mismatches);
+    }
+
+    for (const RGB565Kernels_t *k : backends) {
+        char name[48];
+        snprintf(name, sizeof(name), "kernels/%s/dim", k->name);
+        bench_measure(name, frames, [&]() { k->dim(a.data(), actual.data(), N, 180); }, N, "px");
+        snprintf(name, sizeof(name), "kernels/%s/blend", k->name);
+        bench_measure(name, frames, [&]() { k->blend(a.data(), a.data() + 1, actual.data() + 1, N, 100); }, N, "px");
+        snprintf(name, sizeof(name), "kernels/%s/downscale2", k->name);
+        bench_measure(name, frames, [&]() { k->downscale(a.data(), 64, actual.data(), 32, 32, 2); }, N / 4, "px");
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// 24-bit canvas: a screen's worth of typical drawing (clear, panels, lines, text, an icon) on GFXcanvas24b
+// and converted to 5-6-5 for output, against the same drawing on a GFXcanvas16. At full brightness the two
+// must come out the same.
+// ----------------------------------------------------------------------------------------------------------
+template <typename Canvas>
+static void compose_canvas_screen(Canvas *canvas, const uint16_t *icon) {
+    canvas->fillScreen(0x0);
+    canvas->fillRect(0, 0, 64, 14, 0x18E3);
+    canvas->fillRect(2, 48, 60, 14, 0x2945);
+    canvas->drawFastHLine(0, 15, 64, 0xFFE0);
+    canvas->drawFastVLine(40, 16, 30, 0x07FF);
+    canvas->drawLine(0, 63, 63, 16, 0xF81F);
+    canvas->fillCircle(52, 30, 7, 0xFD20);
+    canvas->setTextColor(0xFFFF);
+    canvas->setCursor(2, 4);
+    canvas->print("21.5C 13kmh");
+    canvas->setCursor(4, 52);
+    canvas->print("12:34");
+    canvas->drawRGBBitmap(4, 16, icon, 32, 32);
+}
+
+static void bench_canvas24(void) {
+    if (!bench_selected("canvas24")) return;
+    uint16_t icon[32 * 32];
+    for (uint16_t i = 0; i < 32 * 32; i++) {
+        uint8_t x = i % 32, y = i / 32;
+        icon[i] = (x << 11) | ((y * 2) << 5) | ((x + y) & 0x1F);
+    }
+    GFXcanvas16 canvas16(64, 64);
+    GFXcanvas24b canvas24(64, 64);
+    std::vector<uint16_t> out(64 * 64);
+
+    bench_measure("canvas24/compose_16", frames, [&]() { compose_canvas_screen(&canvas16, icon); }, 64 * 64, "px");
+    bench_measure("canvas24/compose_24", frames, [&]() { compose_canvas_screen(&canvas24, icon); }, 64 * 64, "px");
+    bench_measure("canvas24/output_565", frames, [&]() { canvas24.toRGB565(out.data()); }, 64 * 64, "px");
+    canvas24.setBrightness(127);
+    bench_measure("canvas24/output_565_dimmed", frames, [&]() { canvas24.toRGB565(out.data()); }, 64 * 64, "px");
+    bench_measure("canvas24/fill_colour", frames, [&]() { canvas24.fillScreen(0xF81F); }, 64 * 64, "px");
+    bench_measure("canvas24/fill_grey", frames, [&]() { canvas24.fillScreen(0x0); }, 64 * 64, "px");
+
+    compose_canvas_screen(&canvas16, icon);
+    compose_canvas_screen(&canvas24, icon);
+    canvas24.setBrightness(255);
+    canvas24.toRGB565(out.data());
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 64 * 64; i++) mismatches += out[i] != canvas16.getBuffer()[i];
+    bench_note("canvas24/output_565", "%u mismatches against GFXcanvas16 at full brightness", mismatches);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Output stage: the per-frame cost of converting a full-brightness screen for the panel at the night
+// brightness, for every kind of dithering, against the per-channel reference (which it must match) and
+// against scaling with the brightness table. Then how far 4x4 block averages of a dimmed gradient are from
+// the exact dimmed value, truncated by the table and dithered.
+// ----------------------------------------------------------------------------------------------------------
+static void bench_output(void) {
+    if (!bench_selected("output")) return;
+    const uint16_t NIGHT = 48;
+    int16_t W = matrix.width(), H = matrix.height();
+    matrix.fillScreen(0x0);
+    redraw_current_screen();
+    std::vector<uint16_t> source(matrix.getBuffer(), matrix.getBuffer() + W * H), out(W * H), ref(W * H);
+    std::vector<uint8_t> source888(W * H * 3);
+    for (int32_t i = 0; i < W * H; i++) {
+        RGB24 c = GFXcanvas24b::color888(source[i]);
+        source888[i * 3] = c.r, source888[i * 3 + 1] = c.g, source888[i * 3 + 2] = c.b;
+    }
+
+    static OutputStage_t stage;
+    BrightnessTable_t table;
+    brightness_build(&table, NIGHT);
+    bench_measure("output/table_scale", frames, [&]() { brightness_scale_buffer(&table, source.data(), out.data(), W * H); }, W * H, "px");
+    const OutputDither modes[] = {OutputDitherNone, OutputDitherOrdered, OutputDitherTemporal};
+    const char *names[] = {"none", "ordered", "temporal"};
+    uint32_t frame = 0, mismatches = 0;
+    for (uint8_t m = 0; m < 3; m++) {
+        output_stage_set(&stage, NIGHT, 220, modes[m]);
+        char name[48];
+        snprintf(name, sizeof(name), "output/565_%s", names[m]);
+        BenchResult_t r = bench_measure(name, frames, [&]() { output_stage_565(&stage, source.data(), out.data(), W, H, frame++); }, W * H, "px");
+        bench_note(name, "%.2f%% of a %uus frame", r.mean_ns / (HOST_FRAME_US * 10.0), (unsigned)HOST_FRAME_US);
+    }
+    bench_measure("output/565_reference", frames, [&]() { output_stage_565_reference(&stage, source.data(), out.data(), W, H, frame++); }, W * H, "px");
+    bench_measure("output/888_temporal", frames, [&]() { output_stage_888(&stage, source888.data(), out.data(), W, H, frame++); }, W * H, "px");
+
+    // every mode, brightness and frame must match the reference; 24-bit input of 565 colours the same
+    for (uint8_t m = 0; m < 3; m++) {
+        for (uint16_t bri = 48; bri <= 256; bri += 16) {
+            output_stage_set(&stage, bri, m == 2 ? 220 : 100, modes[m]);
+            for (uint32_t f = 0; f < 4; f++) {
+                output_stage_565(&stage, source.data(), out.data(), W, H, f);
+                output_stage_565_reference(&stage, source.data(), ref.data(), W, H, f);
+                mismatches += memcmp(out.data(), ref.data(), W * H * sizeof(uint16_t)) != 0;
+                output_stage_888(&stage, source888.data(), ref.data(), W, H, f);
+                mismatches += memcmp(out.data(), ref.data(), W * H * sizeof(uint16_t)) != 0;
+            }
+        }
+    }
+    bench_note("output/565_reference", "%u mismatching frames, fast and 24-bit against reference", mismatches);
+
+    // at full brightness, linear and undithered, the panel gets the frame back (green to its top 5 bits)
+    output_stage_set(&stage, 256, 100, OutputDitherNone);
+    output_stage_565(&stage, source.data(), out.data(), W, H, 0);
+    uint32_t changed = 0;
+    for (int32_t i = 0; i < W * H; i++) changed += ((out[i] ^ source[i]) & 0xFFDF) != 0;
+    bench_note("output/565_none", "full brightness passes the frame through: %s", bench_check("output/565_none", changed == 0));
+
+    // a red ramp, every value twice, 4x4 blocks: average panel level against the exact level
+    std::vector<uint16_t> ramp(W * H);
+    for (int32_t i = 0; i < W * H; i++) ramp[i] = ((i % W) / 2) << 11;
+    brightness_scale_buffer(&table, ramp.data(), ref.data(), W * H);
+    output_stage_set(&stage, NIGHT, 100, OutputDitherOrdered);
+    output_stage_565(&stage, ramp.data(), out.data(), W, H, 0);
+    double table_error = 0, dither_error = 0;
+    uint32_t table_levels = 0, last_level = ~0u;
+    for (int16_t bx = 0; bx < W; bx += 4) {
+        double exact = 0, truncated = 0, dithered = 0;
+        for (int16_t y = 0; y < 4; y++) {
+            for (int16_t x = bx; x < bx + 4; x++) {
+                exact += (ramp[y * W + x] >> 11) * NIGHT / 256.0;
+                truncated += ref[y * W + x] >> 11;
+                dithered += out[y * W + x] >> 11;
+            }
+        }
+        table_error += fabs(truncated - exact) / 16;
+        dither_error += fabs(dithered - exact) / 16;
+        if ((uint32_t)truncated != last_level) table_levels++, last_level = truncated;
+    }
+    bench_note("output/565_ordered", "red ramp at %u/256: %u levels from the table, block error %.3f table, %.3f dithered, better: %s",
+               NIGHT, table_levels, table_error / (W / 4), dither_error / (W / 4), bench_check("output/565_ordered", dither_error < table_error));
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Scheduler: loop() is called at different rates (as if frames cost more or less); the animation must
+// advance by the same number of ticks per simulated second unless the catch-up limit is exceeded
+// ----------------------------------------------------------------------------------------------------------
+static void bench_schedule(void) {
+    if (!bench_selected("schedule")) return;
+    const uint32_t periods_us[] = {1000, 10000, 30000, 80000, 150000};
+    for (uint32_t period_us : periods_us) {
+        loop(); // catch up with the time other benchmarks spent without running loop()
+        scheduler_reset_stats();
+        uint64_t start = host_clock_us();
+        while (host_clock_us() - start < 10 * 1000000ULL) {
+            host_clock_advance_us(period_us);
+            loop();
+        }
+        const FrameSchedulerStats_t &fs = scheduler_stats();
+        char name[48];
+        snprintf(name, sizeof(name), "schedule/loop_every_%ums", period_us / 1000);
+        bench_note(name, "%.1f ticks/s (%u dropped), rendered=%u idle=%u",
+                   fs.ticks / ((host_clock_us() - start) / 1e6), fs.ticks_dropped, fs.frames_rendered, fs.frames_idle);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Transitions: mixing one step of each kind, then whole transitions run through loop(), with a frame every
+// tick and with a frame every third tick (fewer steps, same length). A transition whose steps are all over
+// budget still ends on time. Once it has, the screen must match a full redraw of the incoming screen.
+// ----------------------------------------------------------------------------------------------------------
+static void bench_transition_loop(const char *name, TransitionKind kind, uint8_t ticks_per_frame) {
+    showing_forecast = !showing_forecast;
+    start_screen_transition(kind);
+    TransitionStats_t before = screen_transition.stats;
+    uint64_t start = host_clock_us();
+    uint32_t shown = matrix.getFrameCount(), loops = 0;
+    while (screen != &matrix && loops < 1000) {
+        host_clock_advance_us(ticks_per_frame * HOST_FRAME_US);
+        loop();
+        loops++;
+    }
+    const TransitionStats_t &after = screen_transition.stats;
+    bench_note(name, "%u frames shown over %.0fms, %u steps mixed, %u skipped",
+               matrix.getFrameCount() - shown, (host_clock_us() - start) / 1000.0,
+               after.steps_shown - before.steps_shown, after.steps_skipped - before.steps_skipped);
+
+    size_t bytes = matrix.width() * matrix.height() * sizeof(uint16_t);
+    std::vector<uint16_t> ended(matrix.getBuffer(), matrix.getBuffer() + bytes / 2);
+    matrix.fillScreen(0x0);
+    showing_forecast ? display_forecast_weather() : redraw_current_screen();
+    bench_note(name, "ends on the incoming screen: %s", bench_check(name, !memcmp(ended.data(), matrix.getBuffer(), bytes)));
+    compositor_invalidate_all();
+}
+
+static void bench_transition(void) {
+    if (!bench_selected("transition")) return;
+    const TransitionKind kinds[] = {TransitionCrossfade, TransitionSlide, TransitionWipe};
+    const char *names[] = {"crossfade", "slide", "wipe"};
+    int16_t W = matrix.width(), H = matrix.height();
+
+    ScreenTransition_t t;
+    if (!transition_begin(&t, W, H)) return;
+    std::vector<uint16_t> out(W * H);
+    matrix.fillScreen(0x0);
+    display_forecast_weather();
+    memcpy(t.to->getBuffer(), matrix.getBuffer(), W * H * sizeof(uint16_t));
+    matrix.fillScreen(0x0);
+    redraw_current_screen();
+    char name[48];
+    for (uint8_t k = 0; k < 3; k++) {
+        transition_start(&t, kinds[k], matrix.getBuffer(), 64);
+        snprintf(name, sizeof(name), "transition/step_%s", names[k]);
+        bench_measure(name, frames, [&]() {
+            if (!transition_advance(&t, 1)) transition_start(&t, kinds[k], matrix.getBuffer(), 64);
+            transition_render(&t, out.data(), INT32_MAX);
+        }, W * H, "px");
+    }
+
+    uint64_t swap_time = next_swap_time;
+    next_swap_time = ~0ULL; // no swaps but ours
+    for (uint8_t k = 0; k < 3; k++) {
+        snprintf(name, sizeof(name), "transition/%s", names[k]);
+        bench_transition_loop(name, kinds[k], 1);
+        snprintf(name, sizeof(name), "transition/%s_slow", names[k]);
+        bench_transition_loop(name, kinds[k], 3);
+    }
+    screen_transition.step_us = 1000000; // every step over budget
+    bench_transition_loop("transition/over_budget", TransitionCrossfade, 1);
+    next_swap_time = swap_time;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Frame pipeline: the current weather screen composed in full every frame and shown, serially and with a
+// thread standing in for the push task. Latency is from the start of composing a frame until it has been
+// shown, throughput over the whole run; both in wall time. The overlap needs a second core on the host too.
+// ----------------------------------------------------------------------------------------------------------
+static void bench_pipeline_mode(const char *name, uint8_t depth) {
+    frame_pipeline_begin(&matrix, depth, 0, 3);
+    screen = frame_pipeline_canvas();
+
+    std::vector<uint64_t> composed, shown;
+    composed.reserve(frames);
+    shown.reserve(frames);
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> pushed{0};
+    std::thread pusher;
+    if (frame_pipeline_pipelined()) {
+        pusher = std::thread([&]() {
+            while (!stop) {
+                if (frame_pipeline_push_one(1)) {
+                    shown.push_back(host_wall_ns());
+                    pushed++;
+                }
+            }
+        });
+    }
+
+    bench_measure(name, frames, [&]() {
+        composed.push_back(host_wall_ns());
+        host_clock_advance_us(HOST_FRAME_US);
+        update_current_weather();
+        screen->fillScreen(0x0);
+        redraw_current_screen();
+        frame_pipeline_submit(micros());
+        if (!frame_pipeline_pipelined()) shown.push_back(host_wall_ns());
+    });
+
+    uint32_t stalls = frame_pipeline_stats().stalls;
+    if (pusher.joinable()) {
+        while (pushed < frames) std::this_thread::yield(); // (draining in frame_pipeline_begin would move the clock)
+        stop = true;
+        pusher.join();
+    }
+    frame_pipeline_begin(&matrix, 0, 0, 3);
+    screen = frame_pipeline_canvas();
+
+    double total_latency = 0, max_latency = 0;
+    for (size_t i = 0; i < shown.size(); i++) {
+        double latency = (double)(shown[i] - composed[i]);
+        total_latency += latency;
+        max_latency = max(max_latency, latency);
+    }
+    double fps = shown.size() > 1 ? (shown.size() - 1) * 1e9 / (shown.back() - shown.front()) : 0;
+    bench_note(name, "%u shown, %.1f frames/s, latency %.0fus avg %.0fus max, %u stalls",
+               (unsigned)shown.size(), fps, total_latency / max((size_t)1, shown.size()) / 1000, max_latency / 1000, stalls);
+
+    // what reached the matrix must be the last frame composed
+    size_t bytes = matrix.width() * matrix.height() * sizeof(uint16_t);
+    std::vector<uint16_t> last(matrix.getBuffer(), matrix.getBuffer() + bytes / 2);
+    matrix.fillScreen(0x0);
+    redraw_current_screen();
+    bench_note(name, "shown %u/%u, last frame matches: %s", (unsigned)shown.size(), frames,
+               bench_check(name, shown.size() == frames && !memcmp(last.data(), matrix.getBuffer(), bytes)));
+    dump_frame(name);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Show: converting only the changed row pairs into bit planes, against converting the whole frame. After
+// every show the planes being displayed must equal a straightforward conversion of the frame, whichever of
+// the two buffers they are in; the cost is the row pairs converted per show and the time per submit.
+// ----------------------------------------------------------------------------------------------------------
+static void reference_planes(const uint16_t *frame, int16_t w, int16_t h, uint8_t depth, uint8_t *out) {
+    for (int16_t y = 0; y < h / 2; y++) {
+        for (uint8_t plane = 0; plane < depth; plane++) {
+            for (int16_t x = 0; x < w; x++) {
+                uint16_t u = frame[y * w + x], l = frame[(y + h / 2) * w + x];
+                uint8_t rb = 4 - plane, gb = 5 - plane; // 5-bit red and blue, 6-bit green: top bits first
+                *out++ = (((u >> 11) >> rb) & 1) | ((((u >> 5) & 0x3F) >> gb) & 1) << 1 | (((u & 0x1F) >> rb) & 1) << 2 |
+                         (((l >> 11) >> rb) & 1) << 3 | ((((l >> 5) & 0x3F) >> gb) & 1) << 4 | (((l & 0x1F) >> rb) & 1) << 5;
+            }
+        }
+    }
+}
+
+static void bench_show_case(const char *name, bool (*frame)(void), double full_show_ns) {
+    frame_pipeline_begin(&matrix, 0, 0, 3);
+    screen = frame_pipeline_canvas();
+    compositor_invalidate_all();
+    const int16_t w = matrix.width(), h = matrix.height();
+    std::vector<uint8_t> reference((size_t)matrix.getBitDepth() * w * (h / 2));
+    uint32_t submits = 0, mismatched = 0, converted_before = host_protomatter_row_pairs_converted();
+    uint64_t submit_ns = 0;
+    bench_measure(name, frames, [&]() {
+        host_clock_advance_us(HOST_FRAME_US);
+        if (!frame()) return;
+        uint64_t t0 = host_wall_ns();
+        frame_pipeline_submit(micros());
+        submit_ns += host_wall_ns() - t0;
+        submits++;
+        reference_planes(matrix.getBuffer(), w, h, matrix.getBitDepth(), reference.data());
+        if (memcmp(reference.data(), matrix.getPlanes(), reference.size())) mismatched++;
+    });
+    const FramePipelineStats_t &ps = frame_pipeline_stats();
+    uint32_t shows = ps.frames - ps.shows_skipped, converted = host_protomatter_row_pairs_converted() - converted_before;
+    double per_submit_us = submit_ns / 1000.0 / max(1u, submits);
+    bench_note(name, "%u submits: %u skipped, %.1f/%d row pairs per show, %.2fus per submit (full show %.2fus)",
+               submits, ps.shows_skipped, (double)ps.row_pairs_shown / max(1u, shows), h / 2, per_submit_us,
+               full_show_ns / 1000);
+    bench_note(name, "planes match a full conversion after every show: %s, %u row pairs converted as counted: %s",
+               bench_check(name, mismatched == 0), converted, bench_check(name, converted == ps.row_pairs_shown));
+}
+
+static bool show_current_frame(void) {
+    compositor_begin_frame();
+    track_current_screen();
+    return compositor_end_frame(screen);
+}
+
+static bool show_forecast_redraw(void) {
+    screen->fillScreen(0x0);
+    draw_forecast_panel(0);
+    return true;
+}
+
+// a few rows repainted per frame, at random, so the row pairs a buffer is behind on keep changing
+static bool show_random_rows(void) {
+    static uint32_t seed = 1;
+    uint8_t rows = 1 + (seed >> 16) % 6;
+    for (uint8_t i = 0; i < rows; i++) {
+        seed = seed * 1664525 + 1013904223;
+        screen->drawFastHLine((seed >> 8) % screen->width(), (seed >> 16) % screen->height(), 1 + (seed >> 24) % 16,
+                              (uint16_t)(seed >> 4));
+    }
+    return true;
+}
+
+static void bench_show(void) {
+    if (!bench_selected("show")) return;
+    double full_show_ns = bench_measure("show/full", frames, []() { matrix.show(); }).mean_ns;
+    bench_show_case("show/current", show_current_frame, full_show_ns);
+    bench_show_case("show/forecast_redraw", show_forecast_redraw, full_show_ns);
+    bench_show_case("show/random_rows", show_random_rows, full_show_ns);
+    compositor_invalidate_all();
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Ingest: the forecast entries streamed through the filter, against the whole response as a document (as it
+// used to be: buffered in a String when it came over the network). Reports the peak heap each way.
+// ----------------------------------------------------------------------------------------------------------
+static const uint8_t INGEST_ENTRIES = 6; // MAX_FORECASTS
+
+static uint8_t ingest_document(const char *json, ForecastEntry_t *entries) {
+    JsonDocument doc;
+    deserializeJson(doc, json);
+    JsonArray forecasts = doc["list"];
+    uint8_t n = 0;
+    for (; n < INGEST_ENTRIES && n < forecasts.size(); n++) {
+        entries[n].dt = forecasts[n]["dt"];
+        entries[n].temp = forecasts[n]["main"]["temp"];
+        entries[n].wind = forecasts[n]["wind"]["speed"];
+        entries[n].icon = weather_icon_parse(forecasts[n]["weather"][0]["icon"].as<const char *>());
+    }
+    return n;
+}
+
+static bool same_entries(const ForecastEntry_t *a, uint8_t na, const ForecastEntry_t *b, uint8_t nb) {
+    if (na != nb) return false;
+    for (uint8_t i = 0; i < na; i++) {
+        if (a[i].dt != b[i].dt || a[i].temp != b[i].temp || a[i].wind != b[i].wind || a[i].icon != b[i].icon) return false;
+    }
+    return true;
+}
+
+// Measure body, noting the peak heap above what was live before
+static void bench_ingest_case(const char *name, uint32_t iterations, const std::function<void()> &body) {
+    host_alloc_reset_peak();
+    uint64_t live = host_alloc_stats().live_bytes;
+    bench_measure(name, iterations, body);
+    bench_note(name, "peak heap %llu bytes", (unsigned long long)(host_alloc_stats().peak_bytes - live));
+}
+
+static void bench_ingest(void) {
+    if (!bench_selected("ingest")) return;
+    ForecastEntry_t document[INGEST_ENTRIES], streamed[INGEST_ENTRIES];
+    uint8_t n_document = 0, n_streamed = 0;
+    ForecastIngestStats_t stats;
+
+    bench_ingest_case("ingest/document", frames, [&]() { n_document = ingest_document(JSON_FORECAST_WEATHER, document); });
+    bench_ingest_case("ingest/stream", frames, [&]() {
+        CStringStream response(JSON_FORECAST_WEATHER);
+        forecast_stats_start(&stats);
+        n_streamed = forecast_ingest(response, streamed, INGEST_ENTRIES, &stats);
+    });
+    bench_note("ingest/stream", "%u entries of %u bytes, same as the document: %s", n_streamed,
+               (unsigned)strlen(JSON_FORECAST_WEATHER), bench_check("ingest/stream", same_entries(document, n_document, streamed, n_streamed)));
+
+    if (server_url == NULL) {
+        bench_note("ingest/http", "skipped: no --server");
+        return;
+    }
+    String url = String(server_url) + "/data/2.5/forecast?q=Langwarrin,AU&units=metric&appid=host";
+    uint32_t iterations = min(frames, (uint32_t)100);
+    HTTPClient http;
+    int code = 0;
+    bench_ingest_case("ingest/http_string", iterations, [&]() {
+        http.begin(url);
+        code = http.GET();
+        String response = http.getString();
+        http.end();
+        n_document = ingest_document(response.c_str(), document);
+    });
+    bench_note("ingest/http_string", "HTTP %d, %u entries", code, n_document);
+    bench_ingest_case("ingest/http_stream", iterations, [&]() {
+        HttpCache_t cache; // nothing cached: the whole response every time
+        HttpFetchStats_t http_stats = {};
+        code = forecast_fetch(http, url, &cache, &http_stats, streamed, INGEST_ENTRIES, &stats);
+    });
+    bench_note("ingest/http_stream", "HTTP %d, %u entries (%s), same as the document: %s", code, stats.entries,
+               stats.error.c_str(), bench_check("ingest/http_stream", same_entries(document, n_document, streamed, stats.entries)));
+    bench_note("ingest/http_stream", "sketch's own report: %u bytes free before, %u peak use",
+               stats.heap_before, stats.heap_before - stats.heap_low);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// HTTP: a weather refresh as weather_task does it (current weather, then the forecast on the same connection,
+// both conditional), against host/tools/weather_server.py, which checks the requests it gets
+// ----------------------------------------------------------------------------------------------------------
+struct HttpRefresh_t
+{
+    String current_url, forecast_url;
+    HttpCache_t current, forecast;
+    HttpFetchStats_t stats;
+    ForecastEntry_t entries[INGEST_ENTRIES];
+    uint8_t n;
+    int current_code, forecast_code;
+};
+
+static void http_refresh(HTTPClient &client, HttpRefresh_t *r) {
+    r->current_code = http_cache_get(client, r->current_url, &r->current, &r->stats);
+    if (r->current_code == HTTP_CODE_OK) {
+        String response = client.getString();
+        http_cache_end(client, &r->current, &r->stats, response.length(), true);
+    }
+    ForecastIngestStats_t stats;
+    r->forecast_code = forecast_fetch(client, r->forecast_url, &r->forecast, &r->stats, r->entries, INGEST_ENTRIES, &stats);
+    r->n = r->forecast_code == HTTP_CODE_OK ? stats.entries : 0;
+}
+
+static void http_refresh_urls(HttpRefresh_t *r, const char *appid, const char *extra = "") {
+    r->current_url = String(server_url) + "/data/2.5/weather?q=Langwarrin,AU&units=metric&appid=" + appid;
+    r->forecast_url = String(server_url) + "/data/2.5/forecast?q=Langwarrin,AU&units=metric&appid=" + appid + extra;
+}
+
+static String server_control(const char *path) {
+    HTTPClient http;
+    http.begin(String(server_url) + path);
+    int code = http.GET();
+    String body = code == HTTP_CODE_OK ? http.getString() : String();
+    http.end();
+    return body;
+}
+
+static void http_note(const char *name, const HttpRefresh_t *r, const HttpFetchStats_t *before, bool expected) {
+    const HttpFetchStats_t *s = &r->stats;
+    bench_note(name, "HTTP %d/%d: %u requests, %u new connections, %u reused, %u not modified, %u fresh, %u errors, "
+               "%u bytes received, %u saved: %s",
+               r->current_code, r->forecast_code, s->requests - before->requests, s->connections - before->connections,
+               s->reused - before->reused, s->not_modified - before->not_modified, s->fresh - before->fresh,
+               s->errors - before->errors, s->bytes_received - before->bytes_received,
+               s->bytes_saved - before->bytes_saved, bench_check(name, expected, "as expected"));
+}
+
+static void bench_http(void) {
+    if (!bench_selected("http")) return;
+    if (server_url == NULL) {
+        bench_note("http", "skipped: no --server");
+        return;
+    }
+    ForecastEntry_t document[INGEST_ENTRIES];
+    uint8_t n_document = ingest_document(JSON_FORECAST_WEATHER, document);
+    server_control("/reset?host-http"); // the server checks the requests of this client only
+
+    HTTPClient client;
+    HttpRefresh_t r;
+    http_refresh_urls(&r, "host-http");
+    HttpFetchStats_t before = r.stats = {};
+
+    // nothing cached: both in full, the forecast on the connection the current weather opened
+    http_refresh(client, &r);
+    http_note("http/cold", &r, &before,
+              r.current_code == HTTP_CODE_OK && r.forecast_code == HTTP_CODE_OK && r.stats.connections == 1 &&
+                  r.stats.reused == 1 && same_entries(document, n_document, r.entries, r.n));
+
+    // again at once: still fresh, so nothing is asked for
+    uint32_t max_age_ms = min(r.current.max_age_ms, r.forecast.max_age_ms);
+    bench_note("http/fresh", "server's max-age %u s", max_age_ms / 1000);
+    before = r.stats;
+    http_refresh(client, &r);
+    http_note("http/fresh", &r, &before,
+              r.current_code == HTTP_CODE_NOT_MODIFIED && r.forecast_code == HTTP_CODE_NOT_MODIFIED &&
+                  r.stats.requests == before.requests + (max_age_ms ? 0 : 2));
+
+    // once that has run out: both revalidated, answered 304, on one connection
+    delay(max_age_ms);
+    before = r.stats;
+    http_refresh(client, &r);
+    http_note("http/revalidate", &r, &before,
+              r.current_code == HTTP_CODE_NOT_MODIFIED && r.forecast_code == HTTP_CODE_NOT_MODIFIED &&
+                  r.stats.not_modified == before.not_modified + 2 && r.stats.reused >= before.reused + 1 &&
+                  r.stats.bytes_received == before.bytes_received);
+
+    // a new forecast: only that is sent in full
+    server_control("/bump?/data/2.5/forecast");
+    delay(max_age_ms);
+    before = r.stats;
+    http_refresh(client, &r);
+    http_note("http/changed", &r, &before,
+              r.current_code == HTTP_CODE_NOT_MODIFIED && r.forecast_code == HTTP_CODE_OK &&
+                  same_entries(document, n_document, r.entries, r.n));
+
+    // a chunked forecast reads the same (the current weather is still fresh)
+    HttpRefresh_t chunked;
+    http_refresh_urls(&chunked, "host-http", "&chunked=1");
+    chunked.current = r.current;
+    before = chunked.stats = {};
+    http_refresh(client, &chunked);
+    http_note("http/chunked", &chunked, &before,
+              chunked.forecast_code == HTTP_CODE_OK && same_entries(document, n_document, chunked.entries, chunked.n));
+
+    JsonDocument server;
+    deserializeJson(server, server_control("/stats"));
+    uint32_t violations = server["violations"].size(), requests = server["requests"];
+    bench_note("http/server", "%u requests (%u here), %u connections, %u reused, %u not modified, %u violations: %s",
+               requests, r.stats.requests + chunked.stats.requests, server["connections"].as<uint32_t>(),
+               server["reused"].as<uint32_t>(), server["not_modified"].as<uint32_t>(), violations,
+               bench_check("http/server", violations == 0 && requests == r.stats.requests + chunked.stats.requests));
+    for (uint32_t i = 0; i < violations; i++) {
+        bench_note("http/server", "%s", server["violations"][i].as<const char *>());
+    }
+
+    // what a refresh costs, in full and when nothing has changed (not checked by the server: these don't cache)
+    uint32_t iterations = min(frames, (uint32_t)100);
+    HttpRefresh_t timed;
+    http_refresh_urls(&timed, "host-http-timed");
+    bench_measure("http/refresh_full", iterations, [&]() {
+        timed.current = timed.forecast = HttpCache_t();
+        http_refresh(client, &timed);
+    });
+    bench_measure("http/refresh_304", iterations, [&]() {
+        delay(max_age_ms);
+        http_refresh(client, &timed);
+    });
+    bench_note("http/refresh_304", "HTTP %d/%d", timed.current_code, timed.forecast_code);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Fetch: the weather fetch state machine against faults injected by host/tools/weather_server.py, with the
+// steps doing what the sketch's do (check the status, parse, and only then store)
+// ----------------------------------------------------------------------------------------------------------
+static const uint32_t FETCH_INTERVAL_MS = 10 * 60 * 1000;
+static HTTPClient fetch_client;
+static HttpRefresh_t *fetch_target;
+static float fetch_temp;
+
+static WeatherFetchResult fetch_step_current(uint32_t *retry_after_ms) {
+    HttpRefresh_t *r = fetch_target;
+    r->current_code = http_cache_get(fetch_client, r->current_url, &r->current, &r->stats);
+    if (r->current_code == HTTP_CODE_NOT_MODIFIED) return FetchUnchanged;
+    if (r->current_code != HTTP_CODE_OK) {
+        *retry_after_ms = r->stats.retry_after_ms;
+        return FetchFailed;
+    }
+    HttpBodyStream body(fetch_client);
+    String response = body.readString();
+    http_cache_end(fetch_client, &r->current, &r->stats, body.bytesRead(), body.atEnd());
+    JsonDocument doc;
+    if (body.failed() || deserializeJson(doc, response.c_str()) || !doc["main"]["temp"].is<float>()) {
+        r->current = HttpCache_t();
+        return FetchFailed;
+    }
+    fetch_temp = doc["main"]["temp"];
+    return FetchUpdated;
+}
+
+static WeatherFetchResult fetch_step_forecast(uint32_t *retry_after_ms) {
+    HttpRefresh_t *r = fetch_target;
+    ForecastIngestStats_t stats;
+    ForecastEntry_t entries[INGEST_ENTRIES];
+    r->forecast_code = forecast_fetch(fetch_client, r->forecast_url, &r->forecast, &r->stats, entries, INGEST_ENTRIES, &stats);
+    if (r->forecast_code == HTTP_CODE_NOT_MODIFIED) return FetchUnchanged;
+    if (r->forecast_code != HTTP_CODE_OK) {
+        *retry_after_ms = r->stats.retry_after_ms;
+        return FetchFailed;
+    }
+    if (!forecast_complete(&stats, INGEST_ENTRIES)) return FetchFailed;
+    memcpy(r->entries, entries, sizeof(entries));
+    r->n = stats.entries;
+    return FetchUpdated;
+}
+
+// Poll until a refresh has finished or limit_ms has passed (on the simulated clock); false if none did. Each
+// backoff taken is checked against the bounds it should be in.
+static bool fetch_run(WeatherFetch_t *fetch, uint32_t limit_ms, uint32_t retry_after_ms, bool *waits_ok) {
+    uint32_t start_ms = millis();
+    bool ran = false;
+    while (millis() - start_ms < limit_ms) {
+        uint32_t runs = fetch->step_runs, failures = fetch->step_failures, backoff_ms = fetch->backoff_ms;
+        weather_fetch_poll(fetch, millis());
+        ran |= fetch->step_runs != runs;
+        if (fetch->step_failures != failures) {
+            uint32_t wait = fetch->wait_until_ms - millis();
+            *waits_ok &= retry_after_ms ? wait >= retry_after_ms : (wait >= backoff_ms / 2 && wait <= backoff_ms);
+            *waits_ok &= fetch->backoff_ms == min(backoff_ms * 2, (uint32_t)FETCH_BACKOFF_MAX_MS);
+        }
+        if (ran && fetch->state == FetchIdle) return true;
+        delay(100);
+    }
+    return false;
+}
+
+// Run refreshes until every step has succeeded lately or limit_ms has passed; false if they didn't
+static bool fetch_until_fresh(WeatherFetch_t *fetch, uint32_t limit_ms, uint32_t retry_after_ms, bool *waits_ok) {
+    uint32_t start_ms = millis();
+    while (weather_fetch_staleness(fetch, millis()) != WeatherFresh || fetch->state != FetchIdle) {
+        uint32_t spent_ms = millis() - start_ms;
+        if (spent_ms >= limit_ms || !fetch_run(fetch, limit_ms - spent_ms, retry_after_ms, waits_ok)) return false;
+    }
+    return true;
+}
+
+static void fetch_case(const char *name, const char *fault, uint32_t failures, uint32_t retry_after_ms = 0) {
+    static float document_temp = 0;
+    static ForecastEntry_t document[INGEST_ENTRIES];
+    static uint8_t n_document = 0;
+    if (n_document == 0) {
+        JsonDocument doc;
+        deserializeJson(doc, JSON_CURRENT_WEATHER);
+        document_temp = doc["main"]["temp"];
+        n_document = ingest_document(JSON_FORECAST_WEATHER, document);
+    }
+
+    server_control("/reset?host-fetch");
+    if (fault) server_control(fault);
+    HttpRefresh_t r;
+    http_refresh_urls(&r, "host-fetch");
+    r.stats = {};
+    r.n = 0;
+    fetch_target = &r;
+    fetch_temp = 0;
+    fetch_client.end();
+    WeatherFetch_t fetch;
+    weather_fetch_begin(&fetch, FETCH_INTERVAL_MS);
+    weather_fetch_add_step(&fetch, fetch_step_current);
+    weather_fetch_add_step(&fetch, fetch_step_forecast);
+
+    WeatherStaleness staleness_before = weather_fetch_staleness(&fetch, millis());
+    uint32_t start_ms = millis();
+    uint64_t start_ns = host_wall_ns();
+    bool waits_ok = true;
+    bool updated = fetch_until_fresh(&fetch, 30 * 60 * 1000, retry_after_ms, &waits_ok);
+    uint32_t wall_ms = (host_wall_ns() - start_ns) / 1000000;
+    bool data_ok = fetch_temp == document_temp && same_entries(document, n_document, r.entries, r.n);
+
+    JsonDocument server;
+    deserializeJson(server, server_control("/stats"));
+    uint32_t violations = server["violations"].size();
+    bench_note(name, "%u failures, %u retries, ready after %u ms (%u ms wall), longest step %u ms, %u violations: %s",
+               fetch.step_failures, fetch.retries, (uint32_t)(millis() - start_ms), wall_ms, fetch.max_step_us / 1000, violations,
+               bench_check(name, updated && fetch.step_failures == failures && waits_ok && data_ok && violations == 0 &&
+                                     staleness_before == WeatherMissing &&
+                                     weather_fetch_staleness(&fetch, millis()) == WeatherFresh,
+                           "as expected"));
+    for (uint32_t i = 0; i < violations; i++) {
+        bench_note(name, "%s", server["violations"][i].as<const char *>());
+    }
+}
+
+static void bench_fetch(void) {
+    if (!bench_selected("fetch")) return;
+    if (server_url == NULL) {
+        bench_note("fetch", "skipped: no --server");
+        return;
+    }
+    // short deadlines, so the faults cost little wall time
+    http_cache_set_timeouts(fetch_client, 500, 300, 600);
+
+    fetch_case("fetch/clean", NULL, 0);
+    fetch_case("fetch/delay", "/fault?mode=delay&ms=800&count=2", 2);
+    fetch_case("fetch/reset", "/fault?mode=reset&count=2", 2);
+    fetch_case("fetch/5xx", "/fault?mode=status&status=503&count=2", 2);
+    // more failures than a step is tried for: the rest of the refresh goes on, and the next one gets it
+    fetch_case("fetch/5xx_long", "/fault?mode=status&status=503&count=4", 4);
+    fetch_case("fetch/retry_after", "/fault?mode=status&status=429&retry_after=45&count=1", 1, 45000);
+    fetch_case("fetch/garbage", "/fault?mode=garbage&count=1", 1);
+    fetch_case("fetch/trickle", "/fault?mode=trickle&ms=150&count=1", 1);
+
+    // one endpoint down for good: every refresh gives up on it and still fetches the other
+    server_control("/reset?host-fetch");
+    server_control("/fault?mode=status&status=500&count=1000&path=/data/2.5/weather");
+    WeatherFetch_t fetch;
+    HttpRefresh_t r;
+    http_refresh_urls(&r, "host-fetch");
+    r.stats = {};
+    r.n = 0;
+    fetch_target = &r;
+    fetch_temp = 0;
+    fetch_client.end();
+    weather_fetch_begin(&fetch, FETCH_INTERVAL_MS);
+    weather_fetch_add_step(&fetch, fetch_step_current);
+    weather_fetch_add_step(&fetch, fetch_step_forecast);
+    bool waits_ok = true, finished = true;
+    uint8_t forecasts_ok = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        uint32_t forecast_ok_ms = fetch.last_ok_ms[1];
+        finished &= fetch_run(&fetch, FETCH_INTERVAL_MS + 60 * 1000, 0, &waits_ok);
+        forecasts_ok += (fetch.ok_mask & 2) && fetch.last_ok_ms[1] != forecast_ok_ms;
+    }
+    server_control("/fault?count=0");
+    bench_note("fetch/give_up", "3 refreshes: %u failures, %u steps skipped, %u forecasts fetched, current %s: %s",
+               fetch.step_failures, fetch.steps_skipped, forecasts_ok,
+               weather_fetch_staleness(&fetch, millis()) == WeatherMissing ? "missing" : "not missing",
+               bench_check("fetch/give_up", finished && waits_ok && fetch.steps_skipped == 3 &&
+                                                fetch.step_failures == 3 * FETCH_STEP_ATTEMPTS && forecasts_ok == 3 &&
+                                                (fetch.ok_mask & 1) == 0 && r.n > 0 &&
+                                                weather_fetch_staleness(&fetch, millis()) == WeatherMissing,
+                           "as expected"));
+
+    // a server that stays down: what was fetched stays up, and turns stale once a refresh has been missed
+    server_control("/reset?host-fetch");
+    http_refresh_urls(&r, "host-fetch");
+    r.stats = {};
+    fetch_client.end();
+    weather_fetch_begin(&fetch, FETCH_INTERVAL_MS);
+    weather_fetch_add_step(&fetch, fetch_step_current);
+    weather_fetch_add_step(&fetch, fetch_step_forecast);
+    fetch_run(&fetch, 60 * 1000, 0, &waits_ok);
+    float temp = fetch_temp;
+    server_control("/fault?mode=status&status=500&count=1000");
+    const uint32_t down_ms = 2 * FETCH_INTERVAL_MS + 60 * 1000;
+    uint32_t down_start_ms = millis(), refreshes_down = 0;
+    while (millis() - down_start_ms < down_ms) {
+        refreshes_down += fetch_run(&fetch, down_ms - (millis() - down_start_ms), 0, &waits_ok);
+    }
+    WeatherStaleness down = weather_fetch_staleness(&fetch, millis());
+    uint32_t failures = fetch.step_failures;
+    server_control("/fault?count=0");
+    bool recovered = fetch_until_fresh(&fetch, 2 * FETCH_INTERVAL_MS, 0, &waits_ok);
+    bench_note("fetch/stale", "%u failures over %u min down, refreshes ended: %u %s, backoff capped: %s; stale while "
+               "down: %s, same data: %s, fresh again after: %s",
+               failures, down_ms / 60000, refreshes_down, bench_check("fetch/stale", refreshes_down > 0),
+               bench_check("fetch/stale", waits_ok), bench_check("fetch/stale", down == WeatherStale),
+               bench_check("fetch/stale", temp == fetch_temp), bench_check("fetch/stale", recovered));
+}
+
+static void bench_pipeline(void) {
+    if (!bench_selected("pipeline")) return;
+    bench_measure("pipeline/show", frames, []() { matrix.show(); });
+    bench_pipeline_mode("pipeline/serial", 0);
+    bench_pipeline_mode("pipeline/pipelined", 2);
+    bench_note("pipeline/pipelined", "%u hardware threads on this host", std::thread::hardware_concurrency());
+    compositor_invalidate_all();
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--bri") && i + 1 < argc) {
+            brightness = constrain(atoi(argv[++i]), 48, 256);
+        } else if (!strcmp(argv[i], "--ppm") && i + 1 < argc) {
+            ppm_dir = argv[++i];
+        } else if (!strcmp(argv[i], "--only") && i + 1 < argc) {
+            only_group = argv[++i];
+        } else if (!strcmp(argv[i], "--server") && i + 1 < argc) {
+            server_url = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [--bri 48..256] [--ppm DIR] [--only GROUP] [--server URL]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    frame_pipeline_set_output(NULL);
+    frame_pipeline_begin(&matrix, 0, 0, 0);
+    screen = frame_pipeline_canvas();
+
+    // what weather_task and light_sensor_task would have done in the background
+    weather_fetch_setup();
+    while (weather_fetch.state != FetchIdle) weather_fetch_poll(&weather_fetch, millis());
+    build_brightness_lookup(brightness);
+    swap_brightness_lookup();
+
+    bench_render();
+    bench_lanes();
+    bench_text();
+    bench_blit();
+    bench_icon();
+    bench_sheet();
+    bench_raster();
+    bench_lookup();
+    bench_brightness();
+    bench_kernels();
+    bench_canvas24();
+    bench_output();
+    bench_schedule();
+    bench_transition();
+    bench_show();
+    bench_pipeline();
+    bench_ingest();
+    bench_http();
+    bench_fetch();
+
+    bench_note("checks", "%u run, %u failed", checks_run, (unsigned)checks_failed.size());
+    for (const char *name : checks_failed) bench_note("checks", "failed: %s", name);
+    return checks_failed.empty() ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+#include <Adafruit_Protomatter.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// The Protomatter core's conversion and swap, for the stand-in
+// ----------------------------------------------------------------------------------------------------------
+static uint32_t row_pairs_converted = 0;
+
+extern "C" void _PM_convert_565(Protomatter_core *core, uint16_t *source, uint16_t width) {
+    uint8_t *out = (uint8_t *)core->screenData;
+    if (core->doubleBuffer) out += core->bufferSize * (1 - core->activeBuffer);
+    for (uint8_t y = 0; y < core->numRowPairs; y++) {
+        const uint16_t *upper = source + y * width, *lower = upper + core->numRowPairs * width;
+        for (uint8_t plane = 0; plane < core->numPlanes; plane++) {
+            uint8_t r = 15 - plane, g = 10 - plane, b = 4 - plane; // most significant bits of each channel
+            for (uint16_t x = 0; x < width; x++) {
+                uint16_t u = upper[x], l = lower[x];
+                *out++ = ((u >> r) & 1) | (((u >> g) & 1) << 1) | (((u >> b) & 1) << 2) |
+                         (((l >> r) & 1) << 3) | (((l >> g) & 1) << 4) | (((l >> b) & 1) << 5);
+            }
+        }
+    }
+    row_pairs_converted += core->numRowPairs;
+}
+
+// The library asks the refresh interrupt to swap at the end of the frame and waits for it; here it's at once
+extern "C" void _PM_swapbuffer_maybe(Protomatter_core *core) {
+    if (core->doubleBuffer) core->activeBuffer = 1 - core->activeBuffer;
+    core->frameCount++;
+}
+
+uint32_t host_protomatter_row_pairs_converted(void) {
+    return row_pairs_converted;
+}
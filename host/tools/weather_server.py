@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+"""Stand-in for the OpenWeatherMap API, for the host runner's network benchmarks.
+
+Serves the canned responses of host/include/example_json.h, compacted as the real API sends them:
+
+    /data/2.5/weather   current weather
+    /data/2.5/forecast  5 day / 3 hour forecast (40 entries)
+
+    python3 host/tools/weather_server.py [--port 8765] [--max-age 60]
+    .pio/build/native/program --only http --server http://127.0.0.1:8765
+    .pio/build/native/program --only fetch --server http://127.0.0.1:8765
+
+Responses carry a Content-Length (or are chunked, when the query has chunked=1) and the server speaks
+HTTP/1.1, so connections are kept open unless the client asks otherwise. They also carry an ETag, a
+Last-Modified and Cache-Control: max-age, and a request whose If-None-Match or If-Modified-Since matches is
+answered 304 with no body.
+
+The server checks what the client sends and records each problem as a violation:
+
+    - a request without a Host header
+    - a request that does not keep the connection alive (HTTP/1.0, or Connection: close)
+    - a request for a URL the client has been sent before that carries no If-None-Match, or one with
+      an ETag that was never sent for it
+    - likewise for If-Modified-Since, against the Last-Modified that was sent
+
+Control endpoints, not counted:
+
+    /stats      JSON: requests, connections, reused, full, not_modified, faults, bytes_sent, bytes_saved, violations
+    /reset?KEY  clear the stats, forget what has been sent, and from then on count and check only the requests
+                with appid=KEY (all of them, without KEY)
+    /bump?path  give a resource a new version (new ETag and Last-Modified), as if the weather had changed
+    /fault?mode=MODE&count=N[&ms=MS][&status=CODE][&retry_after=S][&path=PATH]
+                answer the next N weather requests (counted or not), or only those for PATH, with a fault instead:
+                    delay    wait MS before answering at all
+                    trickle  send the body a few bytes every MS
+                    reset    drop the connection (RST) without answering
+                    status   answer CODE (default 503), with Retry-After S if given
+                    garbage  answer 200 with a body that isn't JSON
+                a faulty answer doesn't count as having sent the resource: the client may ask for it afresh
+
+Every request is logged to stderr with the bytes sent.
+"""
+
+import argparse
+import socket
+import struct
+import email.utils
+import hashlib
+import json
+import os
+import re
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+EXAMPLE_JSON = os.path.join(HERE, "..", "include", "example_json.h")
+
+
+def load_responses(path):
+    """The raw string literals of example_json.h, by variable name, compacted"""
+    with open(path, encoding="utf-8") as f:
+        source = f.read()
+    responses = {}
+    for name, text in re.findall(r'const char \*(\w+) = R"JSON\((.*?)\)JSON";', source, re.S):
+        responses[name] = json.dumps(json.loads(text), separators=(",", ":")).encode()
+    return responses
+
+
+class Resource:
+    def __init__(self, body):
+        self.body = body
+        self.version = 0
+        self.bump()
+
+    def bump(self):
+        self.version += 1
+        digest = hashlib.sha1(b"%d:" % self.version + self.body).hexdigest()[:16]
+        self.etag = '"%s"' % digest
+        # whole seconds, and later than the last version's even when bumped within the same second
+        self.modified = max(int(time.time()), getattr(self, "modified", 0) + 1)
+        self.last_modified = email.utils.formatdate(self.modified, usegmt=True)
+
+
+class State:
+    """What has been served, shared by the connection threads"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        self.stats = dict(requests=0, connections=0, reused=0, full=0, not_modified=0, faults=0, bytes_sent=0,
+                          bytes_saved=0, violations=[])
+        self.etags_sent = {}  # path and query: every ETag sent for it
+        self.last_modified_sent = {}  # path and query: every Last-Modified sent for it
+        self.appid = None  # of the requests counted and checked; None for all
+        self.fault = None  # query of the /fault request in force
+        self.fault_count = 0
+
+    def violation(self, text):
+        self.stats["violations"].append(text)
+        sys.stderr.write("VIOLATION: %s\n" % text)
+
+
+class WeatherHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    disable_nagle_algorithm = True  # headers and body go out as separate writes
+    routes = {}
+    max_age = 60
+    state = State()
+
+    def setup(self):
+        super().setup()
+        self.served_on_connection = 0
+
+    def do_GET(self):
+        url = urlsplit(self.path)
+        if url.path in ("/stats", "/reset", "/bump", "/fault"):
+            self.control(url)
+            return
+        resource = self.routes.get(url.path)
+        if resource is None:
+            self.send_error(404)
+            return
+        query = parse_qs(url.query)
+        chunked = query.get("chunked") == ["1"]
+
+        state = self.state
+        with state.lock:
+            fault = None
+            if state.fault_count > 0 and state.fault.get("path", [url.path])[0] == url.path:
+                fault = state.fault
+                state.fault_count -= 1
+            not_modified = self.matches(resource) and fault is None
+            if state.appid is None or query.get("appid") == [state.appid]:
+                self.count(resource, not_modified, fault)
+        try:
+            if fault is not None:
+                self.respond_fault(resource, fault)
+            else:
+                self.respond(resource, not_modified, chunked)
+        except (BrokenPipeError, ConnectionResetError):
+            self.close_connection = True  # the client stopped reading once it had what it needed
+
+    def count(self, resource, not_modified, fault):
+        """Check and count a request; called with the state locked"""
+        state = self.state
+        self.check_request(self.path)
+        state.stats["requests"] += 1
+        state.stats["reused" if self.served_on_connection else "connections"] += 1
+        self.served_on_connection += 1
+        if fault is not None:
+            state.stats["faults"] += 1
+            state.etags_sent.pop(self.path, None)  # the client may well drop its copy
+            state.last_modified_sent.pop(self.path, None)
+            return
+        state.etags_sent.setdefault(self.path, set()).add(resource.etag)
+        state.last_modified_sent.setdefault(self.path, set()).add(resource.last_modified)
+        if not_modified:
+            state.stats["not_modified"] += 1
+            state.stats["bytes_saved"] += len(resource.body)
+        else:
+            state.stats["full"] += 1
+            state.stats["bytes_sent"] += len(resource.body)
+
+    def respond(self, resource, not_modified, chunked):
+        self.send_response(304 if not_modified else 200)
+        self.send_header("ETag", resource.etag)
+        self.send_header("Last-Modified", resource.last_modified)
+        self.send_header("Cache-Control", "max-age=%d" % self.max_age)
+        if not_modified:
+            self.end_headers()
+            return
+        self.send_header("Content-Type", "application/json; charset=utf-8")
+        if chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(resource.body)))
+        self.end_headers()
+        if chunked:
+            for i in range(0, len(resource.body), 1000):
+                chunk = resource.body[i:i + 1000]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(chunk), chunk))
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.wfile.write(resource.body)
+
+    def respond_fault(self, resource, fault):
+        mode = fault.get("mode", [""])[0]
+        ms = int(fault.get("ms", ["1000"])[0])
+        if mode == "delay":
+            time.sleep(ms / 1000)
+            self.respond(resource, False, False)
+        elif mode == "trickle":
+            self.send_response(200)
+            self.send_header("Content-Length", str(len(resource.body)))
+            self.end_headers()
+            for i in range(0, len(resource.body), 64):
+                self.wfile.write(resource.body[i:i + 64])
+                time.sleep(ms / 1000)
+        elif mode == "reset":
+            self.connection.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+            self.close_connection = True
+        elif mode == "garbage":
+            body = b"<html>upstream gateway error</html>"
+            self.send_response(200)
+            self.send_header("Content-Type", "text/html")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+        else:
+            self.send_response(int(fault.get("status", ["503"])[0]))
+            if "retry_after" in fault:
+                self.send_header("Retry-After", fault["retry_after"][0])
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+
+    def check_request(self, path):
+        """Record what the client got wrong; by path and query, as the client caches by URL"""
+        state = self.state
+        if not self.headers.get("Host"):
+            state.violation("%s: no Host header" % path)
+        if self.request_version != "HTTP/1.1" or self.headers.get("Connection", "").lower() == "close":
+            state.violation("%s: connection not kept alive (%s, Connection: %s)"
+                            % (path, self.request_version, self.headers.get("Connection")))
+        etags = state.etags_sent.get(path)
+        if etags:
+            etag = self.headers.get("If-None-Match")
+            if etag is None:
+                state.violation("%s: no If-None-Match, though an ETag was sent" % path)
+            elif etag not in etags:
+                state.violation("%s: If-None-Match %s was never sent" % (path, etag))
+        modified = state.last_modified_sent.get(path)
+        if modified:
+            since = self.headers.get("If-Modified-Since")
+            if since is None:
+                state.violation("%s: no If-Modified-Since, though Last-Modified was sent" % path)
+            elif since not in modified:
+                state.violation("%s: If-Modified-Since %s was never sent" % (path, since))
+
+    def matches(self, resource):
+        """Whether the client's copy is current: If-None-Match decides when given, else If-Modified-Since"""
+        etag = self.headers.get("If-None-Match")
+        if etag is not None:
+            return etag == resource.etag
+        since = self.headers.get("If-Modified-Since")
+        if since is not None:
+            try:
+                return email.utils.parsedate_to_datetime(since).timestamp() >= resource.modified
+            except (TypeError, ValueError):
+                return False
+        return False
+
+    def control(self, url):
+        state = self.state
+        with state.lock:
+            if url.path == "/reset":
+                state.reset()
+                state.appid = url.query or None
+            elif url.path == "/fault":
+                state.fault = parse_qs(url.query)
+                state.fault_count = int(state.fault.get("count", ["1"])[0])
+            elif url.path == "/bump":
+                resource = self.routes.get(url.query)
+                if resource is None:
+                    self.send_error(404)
+                    return
+                resource.bump()
+            body = json.dumps(state.stats).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        sys.stderr.write("%s %s\n" % (self.address_string(), format % args))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--bind", default="127.0.0.1")
+    parser.add_argument("--max-age", type=int, default=60, help="Cache-Control: max-age of the responses")
+    args = parser.parse_args()
+
+    responses = load_responses(EXAMPLE_JSON)
+    WeatherHandler.routes = {
+        "/data/2.5/weather": Resource(responses["JSON_CURRENT_WEATHER"]),
+        "/data/2.5/forecast": Resource(responses["JSON_FORECAST_WEATHER"]),
+    }
+    WeatherHandler.max_age = args.max_age
+    server = ThreadingHTTPServer((args.bind, args.port), WeatherHandler)
+    print("serving on http://%s:%d" % server.server_address[:2], flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
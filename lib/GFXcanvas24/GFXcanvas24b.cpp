@@ -8,9 +8,18 @@
 */
 /**************************************************************************/
 GFXcanvas24b::GFXcanvas24b(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-    uint32_t bytes = w * h * 3;
+    uint32_t bytes = (uint32_t)w * h * 3;
+    rows = NULL;
     if ((buffer = (uint8_t *)malloc(bytes))) {
         memset(buffer, 0, bytes);
+        if ((rows = (uint8_t **)malloc(h * sizeof(uint8_t *)))) {
+            for (uint16_t y = 0; y < h; y++) {
+                rows[y] = buffer + (uint32_t)y * w * 3;
+            }
+        } else {
+            free(buffer);
+            buffer = NULL;
+        }
     }
 }
 
@@ -22,12 +31,15 @@ GFXcanvas24b::GFXcanvas24b(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
 GFXcanvas24b::~GFXcanvas24b(void) {
     if (buffer)
         free(buffer);
+    if (rows)
+        free(rows);
 }
 
 /**************************************************************************/
 /*!
-    @brief  Set the brigtness applied to all colours
-    @param  brightness   8-bit brighness
+    @brief  Set the brightness applied to all colours when the canvas is
+            converted for output; what is drawn is kept at full brightness
+    @param  brightness   8-bit brightness
 */
 /**************************************************************************/
 void GFXcanvas24b::setBrightness(uint8_t brightness) {
@@ -36,16 +48,44 @@ void GFXcanvas24b::setBrightness(uint8_t brightness) {
 
 /**************************************************************************/
 /*!
-    @brief  Adjust the colour of an incoming pixel to the canvas' brightness
+    @brief  Adjust a colour to the canvas' brightness, as toRGB565 does
     @param  color  reference to 24-bit RGB Color that is modified on return
 */
 /**************************************************************************/
-void GFXcanvas24b::adjustColorBrightness(RGB24 &color) {
+void GFXcanvas24b::adjustColorBrightness(RGB24 &color) const {
     color.r = (color.r * this->brightness) >> 8;
     color.g = (color.g * this->brightness) >> 8;
     color.b = (color.b * this->brightness) >> 8;
 }
 
+/**************************************************************************/
+/*!
+    @brief  Store n pixels of one colour from p on: a memset when the
+            channels are equal, otherwise the first pixels are written and
+            then copied onto the rest in doubling blocks
+    @param  p      First byte of the first pixel
+    @param  n      Number of pixels
+    @param  color  24-bit RGB Color
+*/
+/**************************************************************************/
+void GFXcanvas24b::fillBytes(uint8_t *p, uint32_t n, RGB24 color) {
+    if (color.r == color.g && color.g == color.b) {
+        memset(p, color.r, n * 3);
+        return;
+    }
+    uint32_t bytes = n * 3, done = bytes < 24 ? bytes : 24;
+    for (uint32_t i = 0; i < done; i += 3) {
+        p[i + 0] = color.r;
+        p[i + 1] = color.g;
+        p[i + 2] = color.b;
+    }
+    while (done < bytes) {
+        uint32_t chunk = done < bytes - done ? done : bytes - done;
+        memcpy(p + done, p, chunk);
+        done += chunk;
+    }
+}
+
 /**************************************************************************/
 /*!
     @brief  Draw a pixel to the canvas framebuffer
@@ -55,11 +95,7 @@ void GFXcanvas24b::adjustColorBrightness(RGB24 &color) {
 */
 /**************************************************************************/
 void GFXcanvas24b::drawPixel(int16_t x, int16_t y, uint16_t color) {
-    RGB24 c;
-    c.r = color >> 11;
-    c.g = (color >> 5) & 0x3F;
-    c.b = color & 0x1F;
-    drawPixel(x, y, c);
+    drawPixel(x, y, color888(color));
 }
 
 /**************************************************************************/
@@ -93,13 +129,10 @@ void GFXcanvas24b::drawPixel(int16_t x, int16_t y, RGB24 color) {
             break;
         }
 
-        t = x + y * WIDTH;
-
-        adjustColorBrightness(color);
-
-        buffer[t + 0] = color.r;
-        buffer[t + 1] = color.g;
-        buffer[t + 2] = color.b;
+        uint8_t *p = rows[y] + x * 3;
+        p[0] = color.r;
+        p[1] = color.g;
+        p[2] = color.b;
     }
 }
 
@@ -146,12 +179,8 @@ RGB24 GFXcanvas24b::getRawPixel(int16_t x, int16_t y) const {
     if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
         return {0};
     if (buffer) {
-        RGB24 c;
-        uint16_t t = x + y * WIDTH;
-        c.r = buffer[t + 0];
-        c.g = buffer[t + 1];
-        c.b = buffer[t + 2];
-        return c;
+        const uint8_t *p = rows[y] + x * 3;
+        return {p[0], p[1], p[2]};
     }
     return {0};
 }
@@ -163,21 +192,22 @@ RGB24 GFXcanvas24b::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas24b::fillScreen(RGB24 color) {
-    adjustColorBrightness(color);
     if (buffer) {
-        if (color.r == color.g && color.g == color.b) {
-            memset(buffer, color.r, WIDTH * HEIGHT * 3);
-        } else {
-            uint32_t i, pixels = WIDTH * HEIGHT * 3;
-            for (i = 0; i < pixels; i += 3) {
-                buffer[i + 0] = color.r;
-                buffer[i + 1] = color.g;
-                buffer[i + 2] = color.b;
-            }
-        }
+        // the rows are contiguous: fill the whole buffer as one long row
+        fillBytes(buffer, (uint32_t)WIDTH * HEIGHT, color);
     }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color
+    @param  color 16-bit 5-6-5 Color to draw line with
+*/
+/**************************************************************************/
+void GFXcanvas24b::fillScreen(uint16_t color) {
+    fillScreen(color888(color));
+}
+
 /**************************************************************************/
 /*!
    @brief    Speed optimized vertical line drawing
@@ -210,8 +240,6 @@ void GFXcanvas24b::drawFastVLine(int16_t x, int16_t y, int16_t h, RGB24 color) {
         h = height() - y;
     }
 
-    adjustColorBrightness(color);
-
     if (getRotation() == 0) {
         drawFastRawVLine(x, y, h, color);
     } else if (getRotation() == 1) {
@@ -262,12 +290,10 @@ void GFXcanvas24b::drawFastHLine(int16_t x, int16_t y, int16_t w, RGB24 color) {
         w += x;
         x = 0;
     }
-    if (x + w >= width()) { // Clip right
+    if (x + w > width()) { // Clip right
         w = width() - x;
     }
 
-    adjustColorBrightness(color);
-
     if (getRotation() == 0) {
         drawFastRawHLine(x, y, w, color);
     } else if (getRotation() == 1) {
@@ -301,12 +327,11 @@ void GFXcanvas24b::drawFastHLine(int16_t x, int16_t y, int16_t w, RGB24 color) {
 /**************************************************************************/
 void GFXcanvas24b::drawFastRawVLine(int16_t x, int16_t y, int16_t h, RGB24 color) {
     // x & y already in raw (rotation 0) coordinates, no need to transform.
-    uint32_t buffer_index = (y * WIDTH + x) * 3;
-    for (uint16_t i = 0; i < h; i++) {
-        buffer[buffer_index + 0] = color.r;
-        buffer[buffer_index + 1] = color.g;
-        buffer[buffer_index + 2] = color.b;
-        buffer_index += WIDTH * 3;
+    for (int16_t i = 0; i < h; i++) {
+        uint8_t *p = rows[y + i] + x * 3;
+        p[0] = color.r;
+        p[1] = color.g;
+        p[2] = color.b;
     }
 }
 
@@ -321,10 +346,164 @@ void GFXcanvas24b::drawFastRawVLine(int16_t x, int16_t y, int16_t h, RGB24 color
 /**************************************************************************/
 void GFXcanvas24b::drawFastRawHLine(int16_t x, int16_t y, int16_t w, RGB24 color) {
     // x & y already in raw (rotation 0) coordinates, no need to transform.
-    uint32_t buffer_index = (y * WIDTH + x) * 3;
-    for (uint32_t i = buffer_index; i < buffer_index + w; i += 3) {
-        buffer[i + 0] = color.r;
-        buffer[i + 1] = color.g;
-        buffer[i + 2] = color.b;
+    fillBytes(rows[y] + x * 3, w, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Speed optimized vertical line drawing
+   @param    x   Line horizontal start point
+   @param    y   Line vertical start point
+   @param    h   length of vertical line to be drawn, including first point
+   @param    color   16-bit 5-6-5 Color to draw line with
+*/
+/**************************************************************************/
+void GFXcanvas24b::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    drawFastVLine(x, y, h, color888(color));
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized horizontal line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including 1st point
+   @param  color  16-bit 5-6-5 Color to draw line with
+*/
+/**************************************************************************/
+void GFXcanvas24b::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    drawFastHLine(x, y, w, color888(color));
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, a row at a time when the canvas isn't rotated
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas24b::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (getRotation() != 0 || !buffer) {
+        Adafruit_GFX::fillRect(x, y, w, h, color);
+        return;
+    }
+    int16_t x1 = x + w, y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+    if (y1 > HEIGHT) y1 = HEIGHT;
+    if (x >= x1 || y >= y1) return;
+    RGB24 c = color888(color);
+    for (int16_t row = y; row < y1; row++) {
+        drawFastRawHLine(x, row, x1 - x, c);
+    }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Clip a bitmap to the (unrotated) canvas
+   @param  x, y   Where its top left corner goes; moved onto the canvas
+   @param  w, h   Its size; reduced to the part on the canvas
+   @param  sx, sy Set to the first bitmap column and row that is drawn
+   @returns False if nothing of it is on the canvas
+*/
+/**************************************************************************/
+bool GFXcanvas24b::clipBitmap(int16_t &x, int16_t &y, int16_t &w, int16_t &h, int16_t &sx, int16_t &sy) const {
+    sx = x < 0 ? -x : 0;
+    sy = y < 0 ? -y : 0;
+    x += sx;
+    y += sy;
+    w -= sx;
+    h -= sy;
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    return w > 0 && h > 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a 16-bit 5-6-5 image, converting a row at a time when the
+           canvas isn't rotated
+   @param  x       Top left corner x coordinate
+   @param  y       Top left corner y coordinate
+   @param  bitmap  Image, w x h
+   @param  w       Width of the image in pixels
+   @param  h       Height of the image in pixels
+*/
+/**************************************************************************/
+void GFXcanvas24b::drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
+    if (getRotation() != 0 || !buffer) {
+        Adafruit_GFX::drawRGBBitmap(x, y, bitmap, w, h);
+        return;
+    }
+    int16_t stride = w, sx, sy;
+    if (!clipBitmap(x, y, w, h, sx, sy)) return;
+    const uint16_t *source = bitmap + sy * stride + sx;
+    for (int16_t row = 0; row < h; row++) {
+        uint8_t *p = rows[y + row] + x * 3;
+        for (int16_t i = 0; i < w; i++) {
+            RGB24 c = color888(source[i]);
+            p[0] = c.r;
+            p[1] = c.g;
+            p[2] = c.b;
+            p += 3;
+        }
+        source += stride;
+    }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a 24-bit image, copying a row at a time when the canvas
+           isn't rotated
+   @param  x       Top left corner x coordinate
+   @param  y       Top left corner y coordinate
+   @param  bitmap  Image, w x h
+   @param  w       Width of the image in pixels
+   @param  h       Height of the image in pixels
+*/
+/**************************************************************************/
+void GFXcanvas24b::drawRGBBitmap(int16_t x, int16_t y, const RGB24 *bitmap, int16_t w, int16_t h) {
+    if (!buffer) return;
+    if (getRotation() != 0) {
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                drawPixel(x + i, y + j, bitmap[j * w + i]);
+            }
+        }
+        return;
+    }
+    int16_t stride = w, sx, sy;
+    if (!clipBitmap(x, y, w, h, sx, sy)) return;
+    const RGB24 *source = bitmap + sy * stride + sx;
+    for (int16_t row = 0; row < h; row++) {
+        memcpy(rows[y + row] + x * 3, source, w * 3);
+        source += stride;
+    }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Convert the whole canvas (unrotated) to 16-bit 5-6-5, applying
+           the brightness
+   @param  dest  WIDTH x HEIGHT pixels
+*/
+/**************************************************************************/
+void GFXcanvas24b::toRGB565(uint16_t *dest) const {
+    if (!buffer) return;
+    const uint8_t *p = buffer;
+    uint32_t n = (uint32_t)WIDTH * HEIGHT;
+    if (brightness == 256) {
+        for (uint32_t i = 0; i < n; i++, p += 3) {
+            dest[i] = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < n; i++, p += 3) {
+        uint8_t r = (p[0] * brightness) >> 8, g = (p[1] * brightness) >> 8, b = (p[2] * brightness) >> 8;
+        dest[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
     }
 }
@@ -1,23 +1,57 @@
+#ifndef _JVDW_GFXCANVAS24B_H
+#define _JVDW_GFXCANVAS24B_H
+
 #include "Adafruit_GFX.h"
 
-///  A GFX 16-bit canvas context for graphics
+///  A 24-bit RGB colour, in the order the canvas stores it
 struct RGB24 {
     uint8_t r, g, b;
 };
 
+/**************************************************************************/
+/*!
+    @brief  A GFX 24-bit canvas context for graphics. Pixels are stored as
+            three bytes, R G B, at full brightness; the brightness is only
+            applied when the canvas is converted for output (toRGB565).
+            16-bit 5-6-5 colours are expanded to 8 bits per channel by
+            replicating their top bits, so a 5-6-5 colour converts back to
+            itself exactly.
+*/
+/**************************************************************************/
 class GFXcanvas24b : public Adafruit_GFX {
 public:
   GFXcanvas24b(uint16_t w, uint16_t h);
   ~GFXcanvas24b(void);
   void setBrightness(uint8_t brightness);
+  uint8_t getBrightness(void) const { return brightness - 1; }
   void drawPixel(int16_t x, int16_t y, RGB24 color);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(RGB24 color);
-  void byteSwap(void);
+  void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, RGB24 color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, RGB24 color);
-  void adjustColorBrightness(RGB24 &c);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, const RGB24 *bitmap, int16_t w, int16_t h);
+  void adjustColorBrightness(RGB24 &c) const;
   RGB24 getPixel(int16_t x, int16_t y) const;
+  void toRGB565(uint16_t *dest) const;
+
+  /**********************************************************************/
+  /*!
+    @brief   Expand a 16-bit 5-6-5 colour to 24 bits
+    @param   color  5-6-5 colour
+    @returns The 24-bit colour
+  */
+  /**********************************************************************/
+  static RGB24 color888(uint16_t color) {
+    uint8_t r = color >> 11, g = (color >> 5) & 0x3F, b = color & 0x1F;
+    return {(uint8_t)((r << 3) | (r >> 2)), (uint8_t)((g << 2) | (g >> 4)), (uint8_t)((b << 3) | (b >> 2))};
+  }
+
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -26,10 +60,25 @@ public:
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
 
+  /**********************************************************************/
+  /*!
+    @brief    Get a pointer to one row of the buffer, in raw (unrotated)
+              coordinates
+    @param    y  Row, 0 .. HEIGHT - 1
+    @returns  A pointer to the row's first pixel (3 bytes per pixel)
+  */
+  /**********************************************************************/
+  uint8_t *getRow(int16_t y) const { return rows[y]; }
+
 protected:
   RGB24 getRawPixel(int16_t x, int16_t y) const;
+  static void fillBytes(uint8_t *p, uint32_t n, RGB24 color);
+  bool clipBitmap(int16_t &x, int16_t &y, int16_t &w, int16_t &h, int16_t &sx, int16_t &sy) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, RGB24 color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, RGB24 color);
   uint8_t *buffer; ///< Raster data: no longer private, allow subclass access
-  uint16_t brightness=255;  ////< Store 8-bit brightness as 16-bit so that multiplications with it are 16-bit by default
-};
\ No newline at end of file
+  uint8_t **rows;  ///< Start of each row in buffer
+  uint16_t brightness=256;  ////< Store 8-bit brightness as 16-bit so that multiplications with it are 16-bit by default
+};
+
+#endif // _JVDW_GFXCANVAS24B_H
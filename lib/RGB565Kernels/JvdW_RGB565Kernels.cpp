@@ -0,0 +1,232 @@
+#include "JvdW_RGB565Kernels.h"
+
+#include <string.h>
+
+/**************************************************************************/
+/*
+    Reference backend
+*/
+/**************************************************************************/
+static void ref_dim(const uint16_t *source, uint16_t *dest, uint32_t n, uint16_t bri) {
+    while (n--) {
+        uint16_t c = *source++;
+        uint16_t r = ((c >> 11) * bri) >> 8, g = (((c >> 5) & 0x3F) * bri) >> 8, b = ((c & 0x1F) * bri) >> 8;
+        *dest++ = (r << 11) | (g << 5) | b;
+    }
+}
+
+static void ref_blend(const uint16_t *a, const uint16_t *b, uint16_t *dest, uint32_t n, uint16_t weight) {
+    uint16_t k0 = weight, k1 = 256 - weight;
+    while (n--) {
+        uint16_t c0 = *a++, c1 = *b++;
+        uint16_t r = ((c0 >> 11) * k0 + (c1 >> 11) * k1) >> 8;
+        uint16_t g = (((c0 >> 5) & 0x3F) * k0 + ((c1 >> 5) & 0x3F) * k1) >> 8;
+        uint16_t bb = ((c0 & 0x1F) * k0 + (c1 & 0x1F) * k1) >> 8;
+        *dest++ = (r << 11) | (g << 5) | bb;
+    }
+}
+
+static void ref_downscale(const uint16_t *source, uint16_t source_stride, uint16_t *dest, uint16_t w, uint16_t h, uint8_t scale) {
+    uint16_t divider = scale * scale;
+    for (uint16_t y = 0; y < h; y++) {
+        for (uint16_t x = 0; x < w; x++) {
+            uint16_t r = 0, g = 0, b = 0;
+            const uint16_t *block = source + (y * scale) * source_stride + x * scale;
+            for (uint8_t j = 0; j < scale; j++) {
+                for (uint8_t i = 0; i < scale; i++) {
+                    uint16_t c = block[j * source_stride + i];
+                    r += c >> 11;
+                    g += (c >> 5) & 0x3F;
+                    b += c & 0x1F;
+                }
+            }
+            *dest++ = ((r / divider) << 11) | ((g / divider) << 5) | (b / divider);
+        }
+    }
+}
+
+const RGB565Kernels_t RGB565_REFERENCE = {"reference", ref_dim, ref_blend, ref_downscale};
+
+/**************************************************************************/
+/*
+    SWAR backend
+
+    dim and blend work on two pixels at once, one in each 16-bit half of a
+    word. Each channel is masked down to the bottom of its half, where
+    multiplying by at most 256 can't carry into the other half (63 * 256
+    < 65536). After the >> 8, the bits that moved across from the upper
+    half are masked away again.
+
+    Halfword loads and stores build the pairs, so the buffers may have any
+    alignment relative to each other (the blend reads pixels x and x + 1).
+    When everything is word aligned, whole words are used instead.
+*/
+/**************************************************************************/
+static inline uint32_t load_pair(const uint16_t *p) {
+    return p[0] | ((uint32_t)p[1] << 16);
+}
+
+static inline void store_pair(uint16_t *p, uint32_t w) {
+    p[0] = w;
+    p[1] = w >> 16;
+}
+
+static inline bool word_aligned(const void *p) {
+    return ((uintptr_t)p & 3) == 0;
+}
+
+static inline uint32_t dim_pair(uint32_t w, uint32_t bri) {
+    uint32_t r = ((((w >> 11) & 0x001F001F) * bri) >> 8) & 0x001F001F;
+    uint32_t g = ((((w >> 5) & 0x003F003F) * bri) >> 8) & 0x003F003F;
+    uint32_t b = (((w & 0x001F001F) * bri) >> 8) & 0x001F001F;
+    return (r << 11) | (g << 5) | b;
+}
+
+static inline uint32_t blend_pair(uint32_t w0, uint32_t w1, uint32_t k0, uint32_t k1) {
+    uint32_t r = ((((w0 >> 11) & 0x001F001F) * k0 + ((w1 >> 11) & 0x001F001F) * k1) >> 8) & 0x001F001F;
+    uint32_t g = ((((w0 >> 5) & 0x003F003F) * k0 + ((w1 >> 5) & 0x003F003F) * k1) >> 8) & 0x003F003F;
+    uint32_t b = (((w0 & 0x001F001F) * k0 + (w1 & 0x001F001F) * k1) >> 8) & 0x001F001F;
+    return (r << 11) | (g << 5) | b;
+}
+
+static void swar_dim(const uint16_t *source, uint16_t *dest, uint32_t n, uint16_t bri) {
+    if (!word_aligned(source) && !word_aligned(dest) && n > 0) {
+        ref_dim(source++, dest++, 1, bri);
+        n--;
+    }
+    uint32_t pairs = n >> 1;
+    if (word_aligned(source) && word_aligned(dest)) {
+        const uint32_t *s = (const uint32_t *)source;
+        uint32_t *d = (uint32_t *)dest;
+        while (pairs--) {
+            *d++ = dim_pair(*s++, bri);
+        }
+    } else {
+        for (uint32_t i = 0; i < pairs; i++) {
+            store_pair(dest + 2 * i, dim_pair(load_pair(source + 2 * i), bri));
+        }
+    }
+    if (n & 1) ref_dim(source + n - 1, dest + n - 1, 1, bri);
+}
+
+static void swar_blend(const uint16_t *a, const uint16_t *b, uint16_t *dest, uint32_t n, uint16_t weight) {
+    uint32_t k0 = weight, k1 = 256 - weight, pairs = n >> 1;
+    for (uint32_t i = 0; i < pairs; i++) {
+        store_pair(dest + 2 * i, blend_pair(load_pair(a + 2 * i), load_pair(b + 2 * i), k0, k1));
+    }
+    if (n & 1) ref_blend(a + n - 1, b + n - 1, dest + n - 1, 1, weight);
+}
+
+// ------------------------------------------------------------------------
+// downscale spreads a pixel over a word as  ---- -ggg ggg- ---- rrrr r--- ---b bbbb
+// ((c | c << 16) & 0x07E0F81F), which leaves 5 spare bits above red and
+// blue and 5 above green: room for the sums of up to 16 pixels, so one
+// addition accumulates all three channels.
+// ------------------------------------------------------------------------
+static inline uint32_t spread(uint16_t c) {
+    return (c | ((uint32_t)c << 16)) & 0x07E0F81F;
+}
+
+static void swar_downscale(const uint16_t *source, uint16_t source_stride, uint16_t *dest, uint16_t w, uint16_t h, uint8_t scale) {
+    if (scale > 4) {
+        ref_downscale(source, source_stride, dest, w, h, scale);
+        return;
+    }
+    uint16_t divider = scale * scale;
+    for (uint16_t y = 0; y < h; y++) {
+        const uint16_t *row = source + (y * scale) * source_stride;
+        for (uint16_t x = 0; x < w; x++) {
+            uint32_t sum = 0;
+            const uint16_t *block = row + x * scale;
+            for (uint8_t j = 0; j < scale; j++) {
+                for (uint8_t i = 0; i < scale; i++) {
+                    sum += spread(block[i]);
+                }
+                block += source_stride;
+            }
+            uint16_t r = (sum >> 11) & 0x3FF, g = sum >> 21, b = sum & 0x3FF;
+            if (scale == 2) {
+                r >>= 2, g >>= 2, b >>= 2;
+            } else if (scale == 4) {
+                r >>= 4, g >>= 4, b >>= 4;
+            } else if (scale != 1) {
+                r /= divider, g /= divider, b /= divider;
+            }
+            *dest++ = (r << 11) | (g << 5) | b;
+        }
+    }
+}
+
+const RGB565Kernels_t RGB565_SWAR = {"swar", swar_dim, swar_blend, swar_downscale};
+
+/**************************************************************************/
+/*
+    ESP32-S3 PIE backend
+
+    dim runs eight pixels per 128-bit register. Each channel is masked in
+    place and multiplied by bri with EE.VMUL.U16, which shifts the 32-bit
+    product right by SAR (8) before keeping the low 16 bits. The field
+    stays in place: ((r << 11) * bri) >> 8 == (r * bri) << 3, which is
+    exactly ((r * bri) >> 8) << 11 once the bits below the field are masked
+    off again (likewise for green; blue needs no mask).
+
+    The loads and stores need 16-byte alignment, so the SWAR kernel handles
+    the unaligned head and tail, and buffers whose alignments differ.
+    blend and downscale use the SWAR kernels.
+*/
+/**************************************************************************/
+#if RGB565_HAS_PIE
+static const uint16_t pie_masks[3][8] __attribute__((aligned(16))) = {
+    {0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800},
+    {0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0},
+    {0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F}};
+
+static void pie_dim(const uint16_t *source, uint16_t *dest, uint32_t n, uint16_t bri) {
+    if ((((uintptr_t)source ^ (uintptr_t)dest) & 15) != 0) {
+        swar_dim(source, dest, n, bri);
+        return;
+    }
+    uint32_t head = ((16 - ((uintptr_t)source & 15)) & 15) / 2;
+    if (head > n) head = n;
+    swar_dim(source, dest, head, bri);
+    source += head, dest += head, n -= head;
+
+    uint16_t bri_vector[8] __attribute__((aligned(16)));
+    for (uint8_t i = 0; i < 8; i++) bri_vector[i] = bri;
+    const uint16_t *masks = &pie_masks[0][0], *b = bri_vector;
+    asm volatile(
+        "ee.vld.128.ip q4, %0, 16\n"
+        "ee.vld.128.ip q5, %0, 16\n"
+        "ee.vld.128.ip q6, %0, 16\n"
+        "ee.vld.128.ip q7, %1, 0\n"
+        : "+r"(masks), "+r"(b)
+        :
+        : "memory");
+
+    for (uint32_t blocks = n >> 3; blocks > 0; blocks--) {
+        asm volatile(
+            "ssai 8\n"
+            "ee.vld.128.ip q0, %0, 16\n"
+            "ee.andq q1, q0, q4\n"
+            "ee.andq q2, q0, q5\n"
+            "ee.andq q3, q0, q6\n"
+            "ee.vmul.u16 q1, q1, q7\n"
+            "ee.vmul.u16 q2, q2, q7\n"
+            "ee.vmul.u16 q3, q3, q7\n"
+            "ee.andq q1, q1, q4\n"
+            "ee.andq q2, q2, q5\n"
+            "ee.orq q1, q1, q2\n"
+            "ee.orq q1, q1, q3\n"
+            "ee.vst.128.ip q1, %1, 16\n"
+            : "+r"(source), "+r"(dest)
+            :
+            : "memory");
+    }
+    swar_dim(source, dest, n & 7, bri);
+}
+
+const RGB565Kernels_t RGB565_PIE = {"pie", pie_dim, swar_blend, swar_downscale};
+const RGB565Kernels_t &RGB565 = RGB565_PIE;
+#else
+const RGB565Kernels_t &RGB565 = RGB565_SWAR;
+#endif
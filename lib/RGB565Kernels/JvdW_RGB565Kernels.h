@@ -0,0 +1,73 @@
+#ifndef _JVDW_RGB565_KERNELS_H
+#define _JVDW_RGB565_KERNELS_H
+
+#include <stdint.h>
+
+// ESP32-S3 PIE (128-bit SIMD) backend, unless disabled with -DRGB565_NO_PIE
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && !defined(RGB565_NO_PIE)
+#define RGB565_HAS_PIE 1
+#else
+#define RGB565_HAS_PIE 0
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Bulk RGB565 pixel kernels. Every backend gives bit-identical
+            results; only the speed differs.
+
+            dim:       each channel c' = (c * bri) >> 8, bri 0..256
+            blend:     each channel c' = (a * weight + b * (256 - weight)) >> 8,
+                       weight 0..256
+            downscale: each output pixel is the per-channel average
+                       (truncated) of a scale x scale block of the source
+*/
+/**************************************************************************/
+struct RGB565Kernels_t
+{
+    const char *name; ///< Backend name, for reports
+
+    /**********************************************************************/
+    /*!
+      @brief  Scale the brightness of n pixels
+      @param  source  Pixels to scale
+      @param  dest    Where to write the result (may be source)
+      @param  n       Number of pixels
+      @param  bri     Brightness, 256 = unchanged
+    */
+    /**********************************************************************/
+    void (*dim)(const uint16_t *source, uint16_t *dest, uint32_t n, uint16_t bri);
+
+    /**********************************************************************/
+    /*!
+      @brief  Blend two runs of n pixels
+      @param  a       First pixels
+      @param  b       Second pixels
+      @param  dest    Where to write the result (may be a or b)
+      @param  n       Number of pixels
+      @param  weight  Weight of a, 0..256 (b gets 256 - weight)
+    */
+    /**********************************************************************/
+    void (*blend)(const uint16_t *a, const uint16_t *b, uint16_t *dest, uint32_t n, uint16_t weight);
+
+    /**********************************************************************/
+    /*!
+      @brief  Box-filter an image down by an integer factor
+      @param  source         Source image
+      @param  source_stride  Source row length, in pixels
+      @param  dest           Destination image (w x h, packed rows)
+      @param  w              Destination width
+      @param  h              Destination height
+      @param  scale          Reduction factor, 1..15
+    */
+    /**********************************************************************/
+    void (*downscale)(const uint16_t *source, uint16_t source_stride, uint16_t *dest, uint16_t w, uint16_t h, uint8_t scale);
+};
+
+extern const RGB565Kernels_t RGB565_REFERENCE; ///< Plain per-pixel code, the definition of the results
+extern const RGB565Kernels_t RGB565_SWAR;      ///< Two pixels (or three channels) per 32-bit operation
+#if RGB565_HAS_PIE
+extern const RGB565Kernels_t RGB565_PIE; ///< ESP32-S3 SIMD, eight pixels per operation where supported
+#endif
+extern const RGB565Kernels_t &RGB565; ///< The fastest backend available on this target
+
+#endif // _JVDW_RGB565_KERNELS_H
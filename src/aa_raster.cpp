@@ -0,0 +1,152 @@
+#include <Arduino.h>
+
+#include "aa_raster.h"
+
+// sin of 0 .. a quarter turn in 64 steps, scaled by AA_TRIG_ONE
+static const int16_t quarter_sine[65] = {
+    0, 402, 804, 1205, 1606, 2006, 2404, 2801, 3196, 3590, 3981, 4370, 4756,
+    5139, 5520, 5897, 6270, 6639, 7005, 7366, 7723, 8076, 8423, 8765, 9102, 9434,
+    9760, 10080, 10394, 10702, 11003, 11297, 11585, 11866, 12140, 12406, 12665, 12916, 13160,
+    13395, 13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978, 15137, 15286, 15426, 15557,
+    15679, 15791, 15893, 15986, 16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379, 16384};
+
+int16_t aa_sin(uint16_t angle) {
+    uint16_t a = angle & 0x3FFF;
+    if (angle & 0x4000) a = 0x4000 - a; // second and fourth quarter run backwards
+    uint8_t i = a >> 8, f = a & 0xFF;
+    int16_t s = quarter_sine[i];
+    if (f) s += ((quarter_sine[i + 1] - s) * f) >> 8;
+    return (angle & 0x8000) ? -s : s;
+}
+
+int16_t aa_cos(uint16_t angle) {
+    return aa_sin(angle + 0x4000);
+}
+
+void aa_plot(const AASurface_t *surface, int16_t x, int16_t y, uint16_t colour, uint16_t coverage) {
+    if (x < 0 || y < 0 || x >= surface->w || y >= surface->h || coverage == 0) return;
+    uint16_t *p = surface->pixels + y * surface->w + x;
+    if (coverage >= 256) {
+        *p = colour;
+        return;
+    }
+    uint16_t bg = *p, k = 256 - coverage;
+    uint16_t r = ((colour >> 11) * coverage + (bg >> 11) * k + 128) >> 8;
+    uint16_t g = (((colour >> 5) & 0x3F) * coverage + ((bg >> 5) & 0x3F) * k + 128) >> 8;
+    uint16_t b = ((colour & 0x1F) * coverage + (bg & 0x1F) * k + 128) >> 8;
+    *p = (r << 11) | (g << 5) | b;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Wu lines: step one pixel at a time along the major axis, splitting each step's coverage between the two
+// pixels the line falls between on the minor axis. The end pixels are weighted by how far the line reaches
+// into them.
+// ----------------------------------------------------------------------------------------------------------
+static inline void plot_axis(const AASurface_t *surface, bool steep, int16_t major, int16_t minor, uint16_t colour, uint16_t coverage) {
+    steep ? aa_plot(surface, minor, major, colour, coverage) : aa_plot(surface, major, minor, colour, coverage);
+}
+
+static void plot_end(const AASurface_t *surface, bool steep, int16_t major, int32_t minor, uint16_t colour, uint16_t gap) {
+    uint16_t f = minor & 0xFF;
+    plot_axis(surface, steep, major, minor >> AA_SHIFT, colour, ((256 - f) * gap) >> 8);
+    plot_axis(surface, steep, major, (minor >> AA_SHIFT) + 1, colour, (f * gap) >> 8);
+}
+
+void aa_line(const AASurface_t *surface, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t colour) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        int32_t t;
+        t = x0, x0 = y0, y0 = t;
+        t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1) {
+        int32_t t;
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+    int32_t dx = x1 - x0, dy = y1 - y0;
+    int32_t gradient = dx == 0 ? (1 << 16) : (int32_t)(((int64_t)dy << 16) / dx); // minor per major, 16.16
+
+    int32_t xend = (x0 + AA_ONE / 2) & ~(AA_ONE - 1);
+    int32_t yend = y0 + (int32_t)(((int64_t)gradient * (xend - x0)) >> 16);
+    int16_t xpx0 = xend >> AA_SHIFT;
+    plot_end(surface, steep, xpx0, yend, colour, AA_ONE - ((x0 + AA_ONE / 2) & (AA_ONE - 1)));
+    int32_t intery = (yend << 8) + gradient; // 16.16
+
+    xend = (x1 + AA_ONE / 2) & ~(AA_ONE - 1);
+    yend = y1 + (int32_t)(((int64_t)gradient * (xend - x1)) >> 16);
+    int16_t xpx1 = xend >> AA_SHIFT;
+    plot_end(surface, steep, xpx1, yend, colour, (x1 + AA_ONE / 2) & (AA_ONE - 1));
+
+    for (int16_t x = xpx0 + 1; x < xpx1; x++) {
+        int16_t y = intery >> 16;
+        uint16_t f = (intery >> 8) & 0xFF;
+        plot_axis(surface, steep, x, y, colour, 256 - f);
+        plot_axis(surface, steep, x, y + 1, colour, f);
+        intery += gradient;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Circles and arcs: the coverage of a pixel is approximated by how far its centre is inside the ring (a
+// pixel whose centre is on the edge is half covered). Arcs are cut by the lines through the centre at
+// their start and end angles, with the same half-pixel ramp across each cut.
+// ----------------------------------------------------------------------------------------------------------
+static uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0, bit = 1UL << 30;
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static inline int32_t ramp(int32_t inside) {
+    inside += AA_ONE / 2;
+    return inside < 0 ? 0 : inside > AA_ONE ? AA_ONE : inside;
+}
+
+static void ring(const AASurface_t *surface, int32_t cx, int32_t cy, int32_t radius, int32_t thickness, uint16_t start, uint16_t end,
+                 bool whole, uint16_t colour) {
+    int32_t half = thickness / 2;
+    int32_t outer = radius + half + AA_ONE / 2, inner = radius - half - AA_ONE / 2;
+    uint32_t outer2 = (uint32_t)outer * outer, inner2 = inner > 0 ? (uint32_t)inner * inner : 0; // 0: no hole
+
+    int16_t x0 = max((int32_t)0, (cx - outer) >> AA_SHIFT), x1 = min((int32_t)surface->w - 1, (cx + outer + AA_ONE - 1) >> AA_SHIFT);
+    int16_t y0 = max((int32_t)0, (cy - outer) >> AA_SHIFT), y1 = min((int32_t)surface->h - 1, (cy + outer + AA_ONE - 1) >> AA_SHIFT);
+
+    int32_t sx = aa_cos(start), sy = aa_sin(start), ex = aa_cos(end), ey = aa_sin(end);
+    bool wide = (uint16_t)(end - start) > 0x8000;
+
+    for (int16_t y = y0; y <= y1; y++) {
+        int32_t dy = ((int32_t)y << AA_SHIFT) - cy;
+        for (int16_t x = x0; x <= x1; x++) {
+            int32_t dx = ((int32_t)x << AA_SHIFT) - cx;
+            uint32_t d2 = (uint32_t)(dx * dx) + (uint32_t)(dy * dy);
+            if (d2 >= outer2 || (inner2 && d2 <= inner2)) continue;
+            int32_t d = isqrt(d2), coverage = ramp(radius + half - d);
+            if (radius > half) coverage = min(coverage, ramp(d - (radius - half)));
+            if (!whole) {
+                int32_t past_start = ramp((sx * dy - sy * dx) >> 14), before_end = ramp((ey * dx - ex * dy) >> 14);
+                int32_t angular = wide ? max(past_start, before_end) : min(past_start, before_end);
+                coverage = (coverage * angular) >> AA_SHIFT;
+            }
+            aa_plot(surface, x, y, colour, coverage);
+        }
+    }
+}
+
+void aa_circle(const AASurface_t *surface, int32_t cx, int32_t cy, int32_t radius, int32_t thickness, uint16_t colour) {
+    ring(surface, cx, cy, radius, thickness, 0, 0, true, colour);
+}
+
+void aa_arc(const AASurface_t *surface, int32_t cx, int32_t cy, int32_t radius, int32_t thickness, uint16_t start, uint16_t end,
+            uint16_t colour) {
+    ring(surface, cx, cy, radius, thickness, start, end, start == end, colour);
+}
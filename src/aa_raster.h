@@ -0,0 +1,43 @@
+#ifndef _JVDW_AA_RASTER_H
+#define _JVDW_AA_RASTER_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Anti-aliased rasterizer for the procedural icons
+//
+// Draws straight into an RGB565 buffer at its final size: every pixel a shape touches is blended towards
+// the shape's colour by how much of the pixel it covers, so there's no need to draw at 2x and box-filter
+// down. All coordinates and lengths are 24.8 fixed point (AA_ONE = one pixel), with pixel centres on whole
+// numbers: the centre of a w pixel wide surface is at AA_ONE * (w - 1) / 2. Angles are 16-bit fractions of
+// a turn (AA_TURN), clockwise from the +x axis as y points down.
+// ----------------------------------------------------------------------------------------------------------
+#define AA_SHIFT 8
+#define AA_ONE (1 << AA_SHIFT)
+#define AA_TURN 65536UL
+#define AA_TRIG_ONE 16384 // aa_sin / aa_cos of a quarter turn
+
+struct AASurface_t
+{
+    uint16_t *pixels;
+    int16_t w, h;
+};
+
+// sin and cos of an angle, scaled by AA_TRIG_ONE, from a quarter-wave table
+int16_t aa_sin(uint16_t angle);
+int16_t aa_cos(uint16_t angle);
+
+// Blend colour into one pixel with coverage 0..256 (clipped)
+void aa_plot(const AASurface_t *surface, int16_t x, int16_t y, uint16_t colour, uint16_t coverage);
+
+// One pixel wide line between two points (Xiaolin Wu)
+void aa_line(const AASurface_t *surface, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t colour);
+
+// Ring of the given radius and thickness; a thickness of twice the radius (or more) fills it in
+void aa_circle(const AASurface_t *surface, int32_t cx, int32_t cy, int32_t radius, int32_t thickness, uint16_t colour);
+
+// The part of a ring from angle start, clockwise, to angle end
+void aa_arc(const AASurface_t *surface, int32_t cx, int32_t cy, int32_t radius, int32_t thickness, uint16_t start, uint16_t end,
+            uint16_t colour);
+
+#endif // _JVDW_AA_RASTER_H
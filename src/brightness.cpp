@@ -0,0 +1,20 @@
+#include <Arduino.h>
+
+#include <JvdW_RGB565Kernels.h>
+
+#include "brightness.h"
+
+void brightness_build(BrightnessTable_t *table, uint16_t bri) {
+    for (uint16_t i = 0; i < 32; i++) {
+        table->r[i] = ((i * bri) >> 8) << 11;
+        table->b[i] = (i * bri) >> 8;
+    }
+    for (uint16_t i = 0; i < 64; i++) {
+        table->g[i] = ((i * bri) >> 8) << 5;
+    }
+    table->bri = bri;
+}
+
+void brightness_scale_buffer(const BrightnessTable_t *table, const uint16_t *source, uint16_t *dest, uint32_t n) {
+    RGB565.dim(source, dest, n, table->bri);
+}
@@ -0,0 +1,29 @@
+#ifndef _JVDW_BRIGHTNESS_H
+#define _JVDW_BRIGHTNESS_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// RGB565 brightness scaling
+//
+// Every channel is scaled on its own, c' = (c * bri) >> 8 with bri in 0..256, so instead of one entry per
+// colour (65536 entries, 128 KB) a table only needs one per channel value: 32 + 64 + 32 entries, already
+// shifted into place. Whole buffers are scaled with the RGB565 dim kernel instead; both give exactly the
+// same result as the full table did.
+// ----------------------------------------------------------------------------------------------------------
+struct BrightnessTable_t
+{
+    uint16_t bri;
+    uint16_t r[32], g[64], b[32];
+};
+
+void brightness_build(BrightnessTable_t *table, uint16_t bri);
+
+static inline uint16_t brightness_scale(const BrightnessTable_t *table, uint16_t c) {
+    return table->r[c >> 11] | table->g[(c >> 5) & 0x3F] | table->b[c & 0x1F];
+}
+
+// Scale n pixels from source into dest (which may be the same buffer)
+void brightness_scale_buffer(const BrightnessTable_t *table, const uint16_t *source, uint16_t *dest, uint32_t n);
+
+#endif // _JVDW_BRIGHTNESS_H
@@ -0,0 +1,265 @@
+#include <Arduino.h>
+
+#include <JvdW_RGB565Kernels.h>
+
+#include "compositor.h"
+
+struct ElementState_t
+{
+    DirtyRect_t bounds;
+    uint32_t signature;
+    ElementDraw_t draw;
+    uint8_t arg;
+    CompositorLayer_t *layer; // NULL for elements drawn by a callback
+    const uint16_t *pixels;   // the layer as it was last tracked
+    uint16_t opacity;
+    uint8_t blend;
+    uint8_t drawn;   // drawn on the target as of the last frame
+    uint8_t tracked; // tracked in the current frame
+    uint8_t redraw;  // scheduled for redraw in the current frame
+};
+
+static ElementState_t elements[COMPOSITOR_MAX_ELEMENTS];
+static uint8_t element_order[COMPOSITOR_MAX_ELEMENTS], element_count = 0;
+static DirtyRect_t damage[COMPOSITOR_MAX_RECTS];
+static uint8_t damage_count = 0;
+static uint8_t damage_everything = true;
+static CompositorStats_t stats = {0};
+
+// ----------------------------------------------------------------------------------------------------------
+// Rectangle helpers
+// ----------------------------------------------------------------------------------------------------------
+static bool rect_empty(const DirtyRect_t &r) {
+    return r.w <= 0 || r.h <= 0;
+}
+
+static bool rect_intersects(const DirtyRect_t &a, const DirtyRect_t &b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static bool rect_contains(const DirtyRect_t &outer, const DirtyRect_t &inner) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+static DirtyRect_t rect_union(const DirtyRect_t &a, const DirtyRect_t &b) {
+    int16_t x0 = min(a.x, b.x), y0 = min(a.y, b.y);
+    int16_t x1 = max(a.x + a.w, b.x + b.w), y1 = max(a.y + a.h, b.y + b.h);
+    return {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+static bool rect_equal(const DirtyRect_t &a, const DirtyRect_t &b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static DirtyRect_t rect_intersection(const DirtyRect_t &a, const DirtyRect_t &b) {
+    int16_t x0 = max(a.x, b.x), y0 = max(a.y, b.y);
+    int16_t x1 = min(a.x + a.w, b.x + b.w), y1 = min(a.y + a.h, b.y + b.h);
+    return {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Add a rectangle to the damage list, folding it into an existing rectangle where they overlap. When the
+// list is full the new rectangle is merged into the first one (over-drawing is safe, under-drawing is not).
+// ----------------------------------------------------------------------------------------------------------
+static void add_damage(DirtyRect_t r) {
+    if (rect_empty(r)) return;
+    for (uint8_t i = 0; i < damage_count; i++) {
+        if (rect_contains(damage[i], r)) return;
+        if (rect_intersects(damage[i], r)) {
+            r = rect_union(damage[i], r);
+            damage[i] = damage[--damage_count];
+            i = (uint8_t)-1; // the grown rectangle may now overlap ones already checked
+        }
+    }
+    if (damage_count < COMPOSITOR_MAX_RECTS) {
+        damage[damage_count++] = r;
+    } else {
+        damage[0] = rect_union(damage[0], r);
+    }
+}
+
+static bool touches_damage(const DirtyRect_t &r) {
+    for (uint8_t i = 0; i < damage_count; i++) {
+        if (rect_intersects(damage[i], r)) return true;
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Frame API
+// ----------------------------------------------------------------------------------------------------------
+void compositor_begin_frame(void) {
+    for (uint8_t i = 0; i < COMPOSITOR_MAX_ELEMENTS; i++) {
+        elements[i].tracked = false;
+        elements[i].redraw = false;
+    }
+    element_count = 0;
+}
+
+void compositor_track(uint8_t id, DirtyRect_t bounds, uint32_t signature, ElementDraw_t draw, uint8_t arg) {
+    if (id >= COMPOSITOR_MAX_ELEMENTS) return;
+    ElementState_t &e = elements[id];
+    if (!e.drawn || e.layer != NULL || e.signature != signature || !rect_equal(e.bounds, bounds) || e.draw != draw || e.arg != arg) {
+        if (e.drawn) add_damage(e.bounds);
+        add_damage(bounds);
+        e.redraw = true;
+    }
+    e.bounds = bounds;
+    e.signature = signature;
+    e.draw = draw;
+    e.arg = arg;
+    e.layer = NULL;
+    e.tracked = true;
+    element_order[element_count++] = id;
+}
+
+void compositor_track_layer(uint8_t id, CompositorLayer_t *layer) {
+    if (id >= COMPOSITOR_MAX_ELEMENTS) return;
+    ElementState_t &e = elements[id];
+    DirtyRect_t bounds = {layer->x, layer->y, layer->w, layer->h};
+    if (!e.drawn || e.layer != layer || layer->dirty || !rect_equal(e.bounds, bounds) || e.pixels != layer->pixels ||
+        e.opacity != layer->opacity || e.blend != layer->blend) {
+        if (e.drawn) add_damage(e.bounds);
+        add_damage(bounds);
+        e.redraw = true;
+    }
+    e.bounds = bounds;
+    e.draw = NULL;
+    e.layer = layer;
+    e.pixels = layer->pixels;
+    e.opacity = layer->opacity;
+    e.blend = layer->blend;
+    e.tracked = true;
+    layer->dirty = false;
+    element_order[element_count++] = id;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Layer blending. Surfaces are premultiplied: a pixel with coverage a over d becomes c * opacity + d * (1 -
+// a * opacity), so a fully covered pixel at full opacity is a plain copy and a clear one leaves d alone.
+// ----------------------------------------------------------------------------------------------------------
+static inline uint16_t luma_coverage(uint16_t c) {
+    uint16_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    return max(max((r << 3) | (r >> 2), (g << 2) | (g >> 4)), (b << 3) | (b >> 2));
+}
+
+static void blend_span(uint16_t *dest, const uint16_t *source, const uint8_t *alpha, uint16_t n, uint8_t blend, uint16_t opacity) {
+    if (blend == BlendOpaque) {
+        if (opacity >= 256) {
+            memcpy(dest, source, n * sizeof(uint16_t));
+        } else {
+            RGB565.blend(source, dest, dest, n, opacity);
+        }
+        return;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t c = source[i];
+        uint16_t a = blend == BlendAlpha ? alpha[i] : luma_coverage(c);
+        if (a == 0) continue;
+        a += a >> 7; // 0..256
+        uint16_t k = 256 - ((a * opacity) >> 8);
+        if (k == 0) {
+            dest[i] = c;
+            continue;
+        }
+        uint16_t d = dest[i];
+        uint16_t r = ((c >> 11) * opacity + (d >> 11) * k) >> 8;
+        uint16_t g = (((c >> 5) & 0x3F) * opacity + ((d >> 5) & 0x3F) * k) >> 8;
+        uint16_t bb = ((c & 0x1F) * opacity + (d & 0x1F) * k) >> 8;
+        dest[i] = (r << 11) | (g << 5) | bb;
+    }
+}
+
+// Blend the part of a layer inside the damage (the target is unrotated, so rows are contiguous)
+static void blend_layer(GFXcanvas16 *target, const CompositorLayer_t *layer) {
+    uint16_t *frame = target->getBuffer();
+    int16_t W = target->width();
+    DirtyRect_t bounds = rect_intersection({layer->x, layer->y, layer->w, layer->h}, {0, 0, W, target->height()});
+    for (uint8_t i = 0; i < damage_count; i++) {
+        DirtyRect_t r = rect_intersection(bounds, damage[i]);
+        if (rect_empty(r)) continue;
+        uint32_t offset = (r.y - layer->y) * layer->stride + (r.x - layer->x);
+        for (int16_t y = 0; y < r.h; y++, offset += layer->stride) {
+            blend_span(frame + (r.y + y) * W + r.x, layer->pixels + offset, layer->alpha ? layer->alpha + offset : NULL, r.w, layer->blend,
+                       layer->opacity);
+        }
+        stats.pixels_blended += r.w * r.h;
+    }
+}
+
+void compositor_invalidate_all(void) {
+    damage_everything = true;
+}
+
+bool compositor_end_frame(GFXcanvas16 *target) {
+    stats.frames++;
+
+    // elements that disappeared since the last frame leave damage behind
+    for (uint8_t i = 0; i < COMPOSITOR_MAX_ELEMENTS; i++) {
+        if (elements[i].drawn && !elements[i].tracked) {
+            add_damage(elements[i].bounds);
+            elements[i].drawn = false;
+        }
+    }
+
+    if (damage_everything) {
+        damage_count = 0;
+        add_damage({0, 0, target->width(), target->height()});
+        damage_everything = false;
+    }
+
+    if (damage_count == 0) {
+        stats.frames_skipped++;
+        return false;
+    }
+
+    // any element touching the damage is repainted; a callback draws all of its element, which damages
+    // whatever that overlaps, while a layer is only blended inside the damage
+    bool grew = true;
+    while (grew) {
+        grew = false;
+        for (uint8_t n = 0; n < element_count; n++) {
+            ElementState_t &e = elements[element_order[n]];
+            if (!e.redraw && touches_damage(e.bounds)) {
+                e.redraw = true;
+                if (e.layer == NULL) {
+                    add_damage(e.bounds);
+                    grew = true;
+                }
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < damage_count; i++) {
+        target->fillRect(damage[i].x, damage[i].y, damage[i].w, damage[i].h, 0);
+        stats.pixels_cleared += damage[i].w * damage[i].h;
+    }
+
+    for (uint8_t n = 0; n < element_count; n++) {
+        ElementState_t &e = elements[element_order[n]];
+        if (e.redraw) {
+            if (e.layer) {
+                blend_layer(target, e.layer);
+            } else {
+                e.draw(e.arg);
+            }
+            stats.elements_drawn++;
+        }
+        e.drawn = true;
+    }
+    damage_count = 0;
+    return true;
+}
+
+const CompositorStats_t &compositor_stats(void) {
+    return stats;
+}
+
+uint32_t compositor_hash(uint32_t hash, const void *data, size_t size) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (size--) {
+        hash ^= *p++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
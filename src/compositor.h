@@ -0,0 +1,82 @@
+#ifndef _JVDW_COMPOSITOR_H
+#define _JVDW_COMPOSITOR_H
+
+#include <Adafruit_GFX.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Dirty-region compositor
+//
+// Every frame the screen code tracks each visible element with its bounds and a signature of its content.
+// An element whose bounds or signature changed since it was last drawn damages both its old and its new
+// rectangle; an element that is no longer tracked damages its old rectangle. At the end of the frame the
+// damaged rectangles are cleared and every element touching them is redrawn in tracking order (which is
+// the painter's order). When nothing was damaged, nothing is drawn and the caller can skip show().
+//
+// An element is either drawn by a callback, or is a layer: a cached surface that the compositor blends
+// onto the target itself, at the layer's position and opacity. A layer is only blended inside the damaged
+// rectangles, so moving it, fading it or changing its pixels repaints just the area it covers, from the
+// cached surfaces of the layers below and above it; nothing is redrawn from scratch. Layers may be
+// partly transparent, so icons can have soft edges and overlays can sit on top of other elements.
+// ----------------------------------------------------------------------------------------------------------
+#define COMPOSITOR_MAX_ELEMENTS 16
+#define COMPOSITOR_MAX_RECTS 16
+
+struct DirtyRect_t
+{
+    int16_t x, y, w, h;
+};
+
+typedef void (*ElementDraw_t)(uint8_t arg);
+
+enum CompositorBlend : uint8_t
+{
+    BlendOpaque = 0, // the surface covers its whole rectangle
+    BlendAlpha,      // alpha holds each pixel's coverage, 0..255; the pixels are premultiplied
+    BlendLuma        // premultiplied over black: a pixel's coverage is its brightest channel (black is clear)
+};
+
+struct CompositorLayer_t
+{
+    const uint16_t *pixels; // cached surface: h rows of w pixels, stride pixels apart
+    const uint8_t *alpha;   // BlendAlpha only, same layout as pixels
+    int16_t x, y;           // position on the target
+    int16_t w, h;
+    uint16_t stride;
+    uint16_t opacity; // 0..256, applied on top of the per-pixel coverage
+    uint8_t blend;    // CompositorBlend
+    uint8_t dirty;    // set by the owner when the surface's pixels changed, cleared when tracked
+};
+
+struct CompositorStats_t
+{
+    uint32_t frames;          // calls to compositor_end_frame()
+    uint32_t frames_skipped;  // frames where nothing was damaged
+    uint32_t elements_drawn;  // total element redraws
+    uint32_t pixels_blended;  // total layer pixels blended onto the target
+    uint32_t pixels_cleared;  // total pixels cleared (with overlaps counted twice)
+};
+
+// Start a frame; every visible element must then be tracked before compositor_end_frame()
+void compositor_begin_frame(void);
+
+// Track element `id` (0..COMPOSITOR_MAX_ELEMENTS-1) for this frame
+void compositor_track(uint8_t id, DirtyRect_t bounds, uint32_t signature, ElementDraw_t draw, uint8_t arg = 0);
+
+// Track layer `id` for this frame. The layer (and the pixels it points at) must stay valid until the
+// frame ends; moving it, changing its opacity, pixel pointer or blend, or marking it dirty repaints it
+void compositor_track_layer(uint8_t id, CompositorLayer_t *layer);
+
+// Damage the whole screen (e.g. something drew on the target behind the compositor's back)
+void compositor_invalidate_all(void);
+
+// Clear the damaged regions of `target` and redraw the affected elements. Returns false if the frame was
+// unchanged and nothing was drawn.
+bool compositor_end_frame(GFXcanvas16 *target);
+
+const CompositorStats_t &compositor_stats(void);
+
+// FNV-1a, for building element signatures out of the values they are drawn from
+uint32_t compositor_hash(uint32_t hash, const void *data, size_t size);
+const uint32_t COMPOSITOR_HASH_SEED = 2166136261UL;
+
+#endif // _JVDW_COMPOSITOR_H
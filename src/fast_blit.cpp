@@ -0,0 +1,69 @@
+#include <Arduino.h>
+
+#include "fast_blit.h"
+
+// Clip the w x h rectangle at x, y to the canvas, moving source along; false if nothing is left
+static bool clip(const GFXcanvas16 *dest, int16_t &x, int16_t &y, const uint16_t *&source, int16_t stride, int16_t &w,
+                 int16_t &h) {
+    if (x < 0) {
+        source -= x;
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        source -= (int32_t)y * stride;
+        h += y;
+        y = 0;
+    }
+    if (x + w > dest->width()) w = dest->width() - x;
+    if (y + h > dest->height()) h = dest->height() - y;
+    return w > 0 && h > 0;
+}
+
+void blit_rgb565(GFXcanvas16 *dest, int16_t x, int16_t y, const uint16_t *source, int16_t stride, int16_t w, int16_t h) {
+    if (dest->getRotation() != 0) {
+        for (int16_t row = 0; row < h; row++) {
+            dest->drawRGBBitmap(x, y + row, source + (int32_t)row * stride, w, 1);
+        }
+        return;
+    }
+    if (!clip(dest, x, y, source, stride, w, h)) return;
+
+    const int16_t dest_w = dest->width();
+    uint16_t *d = dest->getBuffer() + (int32_t)y * dest_w + x;
+    if (w == dest_w && stride == dest_w) {
+        memcpy(d, source, (size_t)w * h * sizeof(uint16_t)); // full-width rows follow on from each other
+        return;
+    }
+    for (; h > 0; h--, d += dest_w, source += stride) {
+        memcpy(d, source, w * sizeof(uint16_t));
+    }
+}
+
+void blit_rgb565_keyed(GFXcanvas16 *dest, int16_t x, int16_t y, const uint16_t *source, int16_t stride, int16_t w,
+                       int16_t h, uint16_t key) {
+    if (dest->getRotation() != 0) {
+        for (int16_t row = 0; row < h; row++) {
+            for (int16_t col = 0; col < w; col++) {
+                uint16_t c = source[(int32_t)row * stride + col];
+                if (c != key) dest->drawPixel(x + col, y + row, c);
+            }
+        }
+        return;
+    }
+    if (!clip(dest, x, y, source, stride, w, h)) return;
+
+    const int16_t dest_w = dest->width();
+    uint16_t *d = dest->getBuffer() + (int32_t)y * dest_w + x;
+    for (; h > 0; h--, d += dest_w, source += stride) {
+        for (int16_t i = 0; i < w;) {
+            if (source[i] == key) {
+                i++;
+                continue;
+            }
+            int16_t start = i;
+            while (i < w && source[i] != key) i++;
+            memcpy(d + start, source + start, (i - start) * sizeof(uint16_t));
+        }
+    }
+}
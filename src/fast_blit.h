@@ -0,0 +1,40 @@
+#ifndef _JVDW_FAST_BLIT_H
+#define _JVDW_FAST_BLIT_H
+
+#include <Adafruit_GFX.h>
+#include <JvdW_ImageReader.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Row-copy blits into a 16-bit canvas
+//
+// drawRGBBitmap goes through writePixel for every pixel, clipping (and rotating) each one. These clip the
+// rectangle once against the canvas and then copy whole rows straight into its buffer, so they suit the
+// matrix (a GFXcanvas16 itself) as well as any other canvas. The source is a block of RGB565 pixels with
+// rows stride pixels apart, so a part of a larger surface can be blitted as it is.
+//
+// The keyed version leaves the canvas alone wherever the source has the key colour (a sprite's
+// transparent background); the pixels in between are copied as runs.
+//
+// A rotated canvas can't be written row by row: for those the blits fall back to the GFX calls.
+// ----------------------------------------------------------------------------------------------------------
+void blit_rgb565(GFXcanvas16 *dest, int16_t x, int16_t y, const uint16_t *source, int16_t stride, int16_t w, int16_t h);
+void blit_rgb565_keyed(GFXcanvas16 *dest, int16_t x, int16_t y, const uint16_t *source, int16_t stride, int16_t w,
+                       int16_t h, uint16_t key);
+
+static inline void blit_rgb565(GFXcanvas16 *dest, int16_t x, int16_t y, const uint16_t *source, int16_t w, int16_t h) {
+    blit_rgb565(dest, x, y, source, w, w, h);
+}
+
+// A whole canvas (e.g. a PsramCanvas16 surface)
+static inline void blit_canvas(GFXcanvas16 *dest, int16_t x, int16_t y, const GFXcanvas16 *source) {
+    blit_rgb565(dest, x, y, source->getBuffer(), source->width(), source->width(), source->height());
+}
+
+// A loaded image; returns false (drawing nothing) unless it is a 16-bit one
+static inline bool blit_image(GFXcanvas16 *dest, int16_t x, int16_t y, const Adafruit_Image &image) {
+    if (image.getFormat() != IMAGE_16) return false;
+    blit_rgb565(dest, x, y, image.canvas.canvas16->getBuffer(), image.width(), image.width(), image.height());
+    return true;
+}
+
+#endif // _JVDW_FAST_BLIT_H
@@ -0,0 +1,62 @@
+#include "forecast_ingest.h"
+
+void forecast_stats_start(ForecastIngestStats_t *stats) {
+    *stats = {};
+    stats->heap_before = stats->heap_low = ESP.getFreeHeap();
+}
+
+static void sample_heap(ForecastIngestStats_t *stats) {
+    uint32_t free_heap = ESP.getFreeHeap();
+    if (free_heap < stats->heap_low) stats->heap_low = free_heap;
+}
+
+uint8_t forecast_ingest(Stream &stream, ForecastEntry_t *entries, uint8_t max_entries, ForecastIngestStats_t *stats) {
+    uint32_t start_us = micros();
+    stats->entries = 0;
+    stats->error = DeserializationError::Ok;
+
+    // the fields that are used, of each entry
+    JsonDocument filter;
+    filter["dt"] = true;
+    filter["main"]["temp"] = true;
+    filter["wind"]["speed"] = true;
+    filter["weather"][0]["icon"] = true;
+
+    if (stream.find("\"list\"") && stream.find("[")) {
+        JsonDocument entry;
+        while (stats->entries < max_entries) {
+            stats->error = deserializeJson(entry, stream, DeserializationOption::Filter(filter));
+            if (stats->error) break;
+            sample_heap(stats);
+
+            ForecastEntry_t *e = &entries[stats->entries++];
+            e->dt = entry["dt"];
+            e->temp = entry["main"]["temp"];
+            e->wind = entry["wind"]["speed"];
+            e->icon = weather_icon_parse(entry["weather"][0]["icon"].as<const char *>());
+            if (!stream.findUntil(",", "]")) break; // that was the last one
+        }
+    } else {
+        stats->error = DeserializationError::InvalidInput;
+    }
+    stats->parse_us = micros() - start_us;
+    return stats->entries;
+}
+
+bool forecast_complete(const ForecastIngestStats_t *stats, uint8_t max_entries) {
+    return stats->entries > 0 && (stats->entries == max_entries || !stats->error);
+}
+
+int forecast_fetch(HTTPClient &client, const String &url, HttpCache_t *cache, HttpFetchStats_t *http_stats,
+                   ForecastEntry_t *entries, uint8_t max_entries, ForecastIngestStats_t *stats) {
+    forecast_stats_start(stats);
+    int code = http_cache_get(client, url, cache, http_stats);
+    sample_heap(stats);
+    if (code != HTTP_CODE_OK) return code;
+
+    HttpBodyStream body(client);
+    forecast_ingest(body, entries, max_entries, stats);
+    http_cache_end(client, cache, http_stats, body.bytesRead(), body.atEnd());
+    if (!forecast_complete(stats, max_entries)) *cache = HttpCache_t(); // ask for all of it next time
+    return code;
+}
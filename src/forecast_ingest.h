@@ -0,0 +1,70 @@
+#ifndef _JVDW_FORECAST_INGEST_H
+#define _JVDW_FORECAST_INGEST_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <HTTPClient.h>
+#include <time.h>
+
+#include "http_cache.h"
+#include "weather_icon.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Streaming forecast ingest
+//
+// The 5 day / 3 hour forecast is about 16 KB of JSON with 40 entries, of which the panel shows the first
+// few and four fields of each. Rather than buffering the response and building a document of all of it, the
+// entries of its "list" array are parsed one at a time straight off the stream, each through a filter that
+// keeps only those fields, so at most one small entry is held at a time. Reading stops after the entries
+// that are needed; the rest of the response is never read (the connection is closed instead). The fetch is
+// conditional, and a 304 leaves nothing to parse.
+//
+// The free heap is sampled before and while each entry is held, which gives the (approximate) peak the
+// ingest adds on top of what was in use.
+// ----------------------------------------------------------------------------------------------------------
+struct ForecastEntry_t
+{
+    time_t dt; // UTC
+    float temp, wind;
+    WeatherIcon_t icon;
+};
+
+struct ForecastIngestStats_t
+{
+    uint8_t entries;
+    DeserializationError error; // of the entry that ended the ingest early, if any
+    uint32_t parse_us;
+    uint32_t heap_before, heap_low; // free heap before the request, and the lowest seen until the end
+};
+
+// Clear the stats and take the free heap to measure from
+void forecast_stats_start(ForecastIngestStats_t *stats);
+
+// Read up to max_entries entries of the "list" array of a forecast response from stream; returns how many.
+// The stats are to have been started.
+uint8_t forecast_ingest(Stream &stream, ForecastEntry_t *entries, uint8_t max_entries, ForecastIngestStats_t *stats);
+
+// Whether an ingest read enough to be used: all the entries wanted, or fewer only because the list ended
+bool forecast_complete(const ForecastIngestStats_t *stats, uint8_t max_entries);
+
+// GET url, conditionally (see http_cache.h), and ingest the response (starting the stats). Returns
+// HTTP_CODE_OK with the entries read (check forecast_complete: the body may have been cut short or not be a
+// forecast), HTTP_CODE_NOT_MODIFIED if the last entries read are still current, or the status or the client's
+// (negative) error. The connection is closed when only part of the response was read, which is the usual case.
+int forecast_fetch(HTTPClient &client, const String &url, HttpCache_t *cache, HttpFetchStats_t *http_stats,
+                   ForecastEntry_t *entries, uint8_t max_entries, ForecastIngestStats_t *stats);
+
+// A read-only Stream over a string in memory, to ingest canned responses the same way
+class CStringStream : public Stream {
+public:
+    CStringStream(const char *text) : p(text) {}
+    int available() override { return strlen(p); }
+    int read() override { return *p ? (uint8_t)*p++ : -1; }
+    int peek() override { return *p ? (uint8_t)*p : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    const char *p;
+};
+
+#endif // _JVDW_FORECAST_INGEST_H
@@ -0,0 +1,16 @@
+#ifndef _JVDW_FORECAST_PANEL_H
+#define _JVDW_FORECAST_PANEL_H
+
+#include <Arduino.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Forecast panel cache: the forecast rows are rendered into a full-screen PsramCanvas16 once per weather
+// update or brightness change, and that surface is blitted while the forecast is on screen
+// ----------------------------------------------------------------------------------------------------------
+struct ForecastPanelStats_t
+{
+    uint32_t hits;   // draws that blitted the surface as it was
+    uint32_t misses; // draws that had to render it again first
+};
+
+#endif // _JVDW_FORECAST_PANEL_H
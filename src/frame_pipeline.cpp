@@ -0,0 +1,198 @@
+#include <Arduino.h>
+
+#include <freertos/queue.h>
+
+#include "frame_pipeline.h"
+#include "protomatter_rows.h"
+
+static Adafruit_Protomatter *matrix = NULL;
+static GFXcanvas16 *back = NULL;                       // pipelined mode: where frames are composed
+static uint16_t *slots[FRAME_PIPELINE_MAX_DEPTH] = {0}; // frames on their way to the matrix
+static uint32_t slot_start_us[FRAME_PIPELINE_MAX_DEPTH];
+static QueueHandle_t free_slots = NULL, ready_slots = NULL;
+static TaskHandle_t push_task_handle = NULL;
+static uint8_t depth = 0;
+static bool pipelined = false;
+static FramePipelineOutput_t output = NULL, next_output = NULL;
+static uint16_t *shown = NULL; // what the matrix buffer held at the last show
+static bool shown_valid = false;
+static uint64_t stale_rows = 0; // row pairs the matrix's other bit-plane buffer is behind on
+static bool by_rows = false;     // only changed row pairs are converted
+static bool double_buffered = false;
+static FramePipelineStats_t stats = {0};
+
+static size_t frame_bytes(void) {
+    return matrix->width() * matrix->height() * sizeof(uint16_t);
+}
+
+static void record_shown(uint32_t start_us, uint32_t push_start_us) {
+    uint32_t now = micros(), latency = now - start_us, push = now - push_start_us;
+    if (stats.frames == 0) stats.first_shown_us = now;
+    stats.last_shown_us = now;
+    stats.frames++;
+    stats.last_latency_us = latency;
+    stats.total_latency_us += latency;
+    if (latency > stats.max_latency_us) stats.max_latency_us = latency;
+    stats.last_push_us = push;
+    if (push > stats.max_push_us) stats.max_push_us = push;
+}
+
+static uint64_t all_row_pairs(void) {
+    int16_t pairs = matrix->height() / 2;
+    return pairs >= 64 ? ~0ULL : (1ULL << pairs) - 1;
+}
+
+// Row pairs of the matrix buffer that differ from the last show; the copy is brought up to date
+static uint64_t changed_row_pairs(void) {
+    const int16_t w = matrix->width(), h = matrix->height(), pairs = h / 2;
+    if (shown == NULL || pairs > 64) return all_row_pairs();
+
+    const uint16_t *p = matrix->getBuffer();
+    uint16_t *s = shown;
+    uint64_t changed = 0;
+    for (int16_t y = 0; y < h; y++, p += w, s += w) {
+        if (!shown_valid || memcmp(s, p, w * sizeof(uint16_t))) {
+            memcpy(s, p, w * sizeof(uint16_t));
+            changed |= 1ULL << (y % pairs);
+        }
+    }
+    shown_valid = true;
+    return changed;
+}
+
+static void show_frame(const uint16_t *frame) {
+    if (output) {
+        output(frame, matrix->getBuffer());
+    } else if (frame != matrix->getBuffer()) {
+        memcpy(matrix->getBuffer(), frame, frame_bytes());
+    }
+
+    uint64_t changed = changed_row_pairs();
+    if (changed == 0) {
+        stats.shows_skipped++;
+        return;
+    }
+    uint64_t rows = by_rows ? changed | stale_rows : all_row_pairs();
+    stale_rows = double_buffered ? changed : 0;
+    protomatter_show_rows(matrix, rows);
+    stats.row_pairs_shown += __builtin_popcountll(rows);
+}
+
+static void push_task(void *) {
+    while (true) {
+        frame_pipeline_push_one(portMAX_DELAY);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// The back canvas, slots, queues and task are made the first time they are needed and kept from then on;
+// switching to serial mode waits for the queued frames to be shown
+// ----------------------------------------------------------------------------------------------------------
+static bool allocate_back(void) {
+    if (back == NULL) {
+        back = new GFXcanvas16(matrix->width(), matrix->height());
+        if (back->getBuffer() == NULL) {
+            delete back;
+            back = NULL;
+        }
+    }
+    return back != NULL;
+}
+
+static bool allocate(uint8_t count, int8_t push_core, uint8_t push_priority) {
+    if (!allocate_back()) return false;
+    for (; depth < count; depth++) {
+        slots[depth] = (uint16_t *)heap_caps_malloc(frame_bytes(), MALLOC_CAP_INTERNAL);
+        if (slots[depth] == NULL) break;
+    }
+    if (depth == 0) return false;
+
+    if (free_slots == NULL) {
+        free_slots = xQueueCreate(FRAME_PIPELINE_MAX_DEPTH, sizeof(uint8_t));
+        ready_slots = xQueueCreate(FRAME_PIPELINE_MAX_DEPTH, sizeof(uint8_t));
+        if (free_slots == NULL || ready_slots == NULL) return false;
+        for (uint8_t i = 0; i < depth; i++) {
+            xQueueSend(free_slots, &i, 0);
+        }
+    }
+    if (push_task_handle == NULL) {
+        xTaskCreatePinnedToCore(push_task, "push", 4096, NULL, push_priority, &push_task_handle, push_core);
+    }
+    return push_task_handle != NULL;
+}
+
+bool frame_pipeline_begin(Adafruit_Protomatter *m, uint8_t count, int8_t push_core, uint8_t push_priority) {
+    matrix = m;
+    if (pipelined) {
+        while (uxQueueMessagesWaiting(free_slots) < depth) {
+            vTaskDelay(1);
+        }
+    }
+    if (shown == NULL) shown = (uint16_t *)heap_caps_malloc(frame_bytes(), MALLOC_CAP_INTERNAL); // else: full shows
+    shown_valid = false;
+    by_rows = protomatter_rows_supported(matrix);
+    double_buffered = protomatter_double_buffered(matrix);
+    stale_rows = all_row_pairs();
+    GFXcanvas16 *was = frame_pipeline_canvas();
+    if (count > FRAME_PIPELINE_MAX_DEPTH) count = FRAME_PIPELINE_MAX_DEPTH;
+    pipelined = count > 0 && (depth > 0 || allocate(count, push_core, push_priority));
+    output = (next_output && allocate_back()) ? next_output : NULL;
+    if (was == matrix && frame_pipeline_canvas() == back) {
+        memcpy(back->getBuffer(), matrix->getBuffer(), frame_bytes()); // composition carries on from what's shown
+    }
+    frame_pipeline_reset_stats();
+    return pipelined;
+}
+
+bool frame_pipeline_pipelined(void) {
+    return pipelined;
+}
+
+void frame_pipeline_set_output(FramePipelineOutput_t function) {
+    next_output = function;
+}
+
+GFXcanvas16 *frame_pipeline_canvas(void) {
+    return (pipelined || output) ? back : matrix;
+}
+
+void frame_pipeline_submit(uint32_t compose_start_us) {
+    if (!pipelined) {
+        uint32_t push_start_us = micros();
+        show_frame(frame_pipeline_canvas()->getBuffer());
+        record_shown(compose_start_us, push_start_us);
+        return;
+    }
+
+    uint8_t slot;
+    if (xQueueReceive(free_slots, &slot, 0) != pdTRUE) {
+        stats.stalls++;
+        xQueueReceive(free_slots, &slot, portMAX_DELAY);
+    }
+    memcpy(slots[slot], back->getBuffer(), frame_bytes());
+    slot_start_us[slot] = compose_start_us;
+    xQueueSend(ready_slots, &slot, portMAX_DELAY);
+}
+
+bool frame_pipeline_push_one(TickType_t wait) {
+    uint8_t slot;
+    if (ready_slots == NULL || xQueueReceive(ready_slots, &slot, wait) != pdTRUE) return false;
+    uint32_t push_start_us = micros();
+    show_frame(slots[slot]);
+    record_shown(slot_start_us[slot], push_start_us);
+    xQueueSend(free_slots, &slot, portMAX_DELAY);
+    return true;
+}
+
+uint32_t frame_pipeline_fps_x10(void) {
+    uint32_t span_us = stats.last_shown_us - stats.first_shown_us;
+    return (stats.frames > 1 && span_us) ? (uint64_t)(stats.frames - 1) * 10000000ULL / span_us : 0;
+}
+
+const FramePipelineStats_t &frame_pipeline_stats(void) {
+    return stats;
+}
+
+void frame_pipeline_reset_stats(void) {
+    stats = {0};
+}
@@ -0,0 +1,72 @@
+#ifndef _JVDW_FRAME_PIPELINE_H
+#define _JVDW_FRAME_PIPELINE_H
+
+#include <Adafruit_Protomatter.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Frame pipeline
+//
+// In serial mode frames are composed straight into the matrix and shown from loop(), one after the other.
+// In pipelined mode they are composed into a back canvas. Each finished frame is copied into a free slot
+// and queued for a push task on the other core, which copies it into the matrix and shows it (the bit-plane
+// conversion). That way frame N + 1 is composed while frame N is pushed. There are only a few slots: when
+// the push side falls behind, submitting waits for one to come free, so the compose side can never run
+// ahead by more than the queue depth.
+//
+// An output function can be set to turn each composed frame into what the panel shows (e.g. brightness and
+// dithering) instead of copying it; frames are then composed into the back canvas in serial mode as well.
+//
+// Only the row pairs that changed are converted into bit planes (protomatter_show_rows). A copy of what the
+// matrix buffer held at the last show finds them, row by row; when the matrix's bit planes are double-buffered
+// the buffer written next is also behind by the row pairs that changed in the frame before, and those are
+// converted as well. A frame identical to the one shown isn't shown again. After frame_pipeline_begin the
+// first two shows convert everything, as the matrix may have been shown from elsewhere until then; from then
+// on it should only be shown from here.
+//
+// Latency is measured from the start of a frame's composition until it has been shown. Throughput is
+// measured over the frames shown since the stats were reset.
+// ----------------------------------------------------------------------------------------------------------
+#define FRAME_PIPELINE_MAX_DEPTH 4
+
+struct FramePipelineStats_t
+{
+    uint32_t frames;     // frames shown
+    uint32_t stalls;     // submits that waited for a free slot
+    uint32_t last_latency_us, max_latency_us;
+    uint64_t total_latency_us;
+    uint32_t last_push_us, max_push_us; // copying into the matrix and show()
+    uint32_t shows_skipped;             // frames identical to the one shown before
+    uint32_t row_pairs_shown;           // row pairs converted into bit planes
+    uint32_t first_shown_us, last_shown_us;
+};
+
+// Converts a composed frame into the matrix's framebuffer
+typedef void (*FramePipelineOutput_t)(const uint16_t *frame, uint16_t *panel);
+
+// Set (or with NULL, clear) the output function; takes effect on the next frame_pipeline_begin
+void frame_pipeline_set_output(FramePipelineOutput_t output);
+
+// Start in pipelined mode with depth slots (falls back to serial mode if the buffers or the task can't be
+// had; returns whether it's pipelined), or in serial mode with depth 0. Call again to switch modes.
+bool frame_pipeline_begin(Adafruit_Protomatter *matrix, uint8_t depth, int8_t push_core, uint8_t push_priority);
+
+bool frame_pipeline_pipelined(void);
+
+// Where frames are composed: the matrix itself in serial mode without an output function, otherwise the
+// back canvas
+GFXcanvas16 *frame_pipeline_canvas(void);
+
+// Hand over the frame composed on the canvas, whose composition started at compose_start_us
+void frame_pipeline_submit(uint32_t compose_start_us);
+
+// Push side: show the oldest queued frame, waiting up to wait ticks for one; false if none came. The push
+// task loops on this; it can also be driven by hand.
+bool frame_pipeline_push_one(TickType_t wait);
+
+// Frames shown per second x 10 since the stats were reset
+uint32_t frame_pipeline_fps_x10(void);
+
+const FramePipelineStats_t &frame_pipeline_stats(void);
+void frame_pipeline_reset_stats(void);
+
+#endif // _JVDW_FRAME_PIPELINE_H
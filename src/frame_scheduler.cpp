@@ -0,0 +1,66 @@
+#include <Arduino.h>
+
+#include "frame_scheduler.h"
+
+static uint32_t tick_period_us = 1000000L / 45, next_tick_us = 0;
+static uint8_t max_catchup_ticks = 4;
+static FrameSchedulerStats_t stats = {0};
+
+void scheduler_begin(uint32_t tick_us, uint8_t max_catchup, uint32_t now_us) {
+    tick_period_us = tick_us;
+    max_catchup_ticks = max_catchup ? max_catchup : 1;
+    next_tick_us = now_us + tick_us;
+}
+
+uint8_t scheduler_ticks_due(uint32_t now_us) {
+    if ((int32_t)(now_us - next_tick_us) < 0) return 0;
+
+    // whole ticks elapsed since the one that was due; anything beyond the catch-up limit is dropped so that
+    // a long stall slows the animation down for a moment rather than making it jump
+    uint32_t due = (now_us - next_tick_us) / tick_period_us + 1;
+    next_tick_us += due * tick_period_us;
+    if (due > max_catchup_ticks) {
+        stats.ticks_dropped += due - max_catchup_ticks;
+        due = max_catchup_ticks;
+    }
+    stats.ticks += due;
+    return (uint8_t)due;
+}
+
+void scheduler_frame_done(uint32_t work_us, bool rendered) {
+    uint32_t permille = (uint64_t)work_us * 1000 / tick_period_us;
+    stats.last_work_us = work_us;
+    if (work_us > stats.max_work_us) stats.max_work_us = work_us;
+    if (work_us > tick_period_us) stats.overruns++;
+    stats.last_used_permille = permille > 0xFFFF ? 0xFFFF : permille;
+    stats.avg_used_permille = (stats.avg_used_permille * 15 + stats.last_used_permille) >> 4;
+    if (rendered) {
+        stats.frames_rendered++;
+    } else {
+        stats.frames_idle++;
+    }
+}
+
+uint32_t scheduler_time_to_next_tick(uint32_t now_us) {
+    int32_t remaining = (int32_t)(next_tick_us - now_us);
+    return remaining > 0 ? remaining : 0;
+}
+
+void scheduler_sleep_until_next_tick(void) {
+    uint32_t wait_us = scheduler_time_to_next_tick(micros());
+    if (wait_us >= 1000) {
+        delay(wait_us / 1000); // vTaskDelay underneath, so the idle task gets the time
+    }
+}
+
+uint32_t scheduler_tick_us(void) {
+    return tick_period_us;
+}
+
+const FrameSchedulerStats_t &scheduler_stats(void) {
+    return stats;
+}
+
+void scheduler_reset_stats(void) {
+    stats = {0};
+}
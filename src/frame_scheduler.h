@@ -0,0 +1,45 @@
+#ifndef _JVDW_FRAME_SCHEDULER_H
+#define _JVDW_FRAME_SCHEDULER_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Fixed-timestep frame scheduler
+//
+// Animation advances in fixed simulation ticks, independent of how long a frame takes to render. loop()
+// asks how many ticks are due, advances the animation that many times, renders once, and reports how long
+// that took so the share of the frame budget (one tick) that was used can be tracked. When no tick is due
+// the rest of the budget is slept away, which hands the CPU to the idle task.
+// ----------------------------------------------------------------------------------------------------------
+struct FrameSchedulerStats_t
+{
+    uint32_t ticks;           // simulation ticks run
+    uint32_t ticks_dropped;   // ticks skipped because the loop fell more than max_catchup behind
+    uint32_t frames_rendered; // frames where something was drawn and shown
+    uint32_t frames_idle;     // frames where the ticks changed nothing on screen
+    uint32_t overruns;        // frames whose work took longer than the budget
+    uint32_t last_work_us, max_work_us;
+    uint16_t last_used_permille; // budget used by the last frame, in 1/1000
+    uint16_t avg_used_permille;  // running average (1/16 weight per frame)
+};
+
+// Start ticking every tick_us from now_us; at most max_catchup ticks are run in a single frame
+void scheduler_begin(uint32_t tick_us, uint8_t max_catchup, uint32_t now_us);
+
+// Number of simulation ticks that fell due since the last call (0 if it is not time yet)
+uint8_t scheduler_ticks_due(uint32_t now_us);
+
+// Account for the work done in a frame that ran at least one tick
+void scheduler_frame_done(uint32_t work_us, bool rendered);
+
+// Microseconds until the next tick is due
+uint32_t scheduler_time_to_next_tick(uint32_t now_us);
+
+// Sleep (at millisecond resolution) until the next tick is due
+void scheduler_sleep_until_next_tick(void);
+
+uint32_t scheduler_tick_us(void);
+const FrameSchedulerStats_t &scheduler_stats(void);
+void scheduler_reset_stats(void);
+
+#endif // _JVDW_FRAME_SCHEDULER_H
@@ -0,0 +1,170 @@
+#include "http_cache.h"
+
+#include <strings.h>
+
+static const char *COLLECTED_HEADERS[] = {"ETag", "Last-Modified", "Cache-Control", "Age", "Transfer-Encoding", "Retry-After"};
+
+static uint32_t body_timeout_ms = 0;
+
+void http_cache_set_timeouts(HTTPClient &client, int32_t connect_ms, uint16_t read_ms, uint32_t body_ms) {
+    client.setConnectTimeout(connect_ms);
+    client.setTimeout(read_ms);
+    body_timeout_ms = body_ms;
+}
+
+static bool is_fresh(const HttpCache_t *cache) {
+    return cache->valid && cache->max_age_ms > 0 && millis() - cache->checked_ms < cache->max_age_ms;
+}
+
+// How long the response just received may be used without asking again
+static uint32_t response_max_age_ms(HTTPClient &client) {
+    String cache_control = client.header("Cache-Control");
+    cache_control.toLowerCase();
+    if (cache_control.indexOf("no-cache") >= 0 || cache_control.indexOf("no-store") >= 0) return 0;
+    int at = cache_control.indexOf("max-age=");
+    if (at < 0) return 0;
+    long seconds = cache_control.substring(at + 8).toInt() - client.header("Age").toInt();
+    return seconds > 0 ? seconds * 1000 : 0;
+}
+
+static void count_saved(const HttpCache_t *cache, HttpFetchStats_t *stats) {
+    if (cache->body_bytes > 0) stats->bytes_saved += cache->body_bytes;
+}
+
+int http_cache_get(HTTPClient &client, const String &url, HttpCache_t *cache, HttpFetchStats_t *stats) {
+    if (is_fresh(cache)) {
+        stats->fresh++;
+        count_saved(cache, stats);
+        return HTTP_CODE_NOT_MODIFIED;
+    }
+
+    client.setReuse(true);
+    client.useHTTP10(false); // keep-alive needs HTTP/1.1
+    if (!client.begin(url)) {
+        stats->errors++;
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+    client.collectHeaders(COLLECTED_HEADERS, sizeof(COLLECTED_HEADERS) / sizeof(COLLECTED_HEADERS[0]));
+    if (cache->valid) {
+        if (cache->etag.length()) client.addHeader("If-None-Match", cache->etag);
+        if (cache->last_modified.length()) client.addHeader("If-Modified-Since", cache->last_modified);
+    }
+
+    bool open = client.connected(); // left so by the request before
+    int code = client.GET();
+    stats->requests++;
+    stats->retry_after_ms = 0;
+    if (open) {
+        stats->reused++;
+    } else {
+        stats->connections++;
+    }
+    if (code == HTTP_CODE_OK) return code; // the caller reads the body
+
+    if (code == HTTP_CODE_NOT_MODIFIED && cache->valid) {
+        stats->not_modified++;
+        count_saved(cache, stats);
+        cache->checked_ms = millis();
+        cache->max_age_ms = response_max_age_ms(client);
+        if (client.hasHeader("ETag")) cache->etag = client.header("ETag");
+    } else {
+        stats->errors++;
+        // only the delay-seconds form: an HTTP date would need the wall clock to be right
+        if (code == HTTP_CODE_TOO_MANY_REQUESTS || code == HTTP_CODE_SERVICE_UNAVAILABLE) {
+            stats->retry_after_ms = client.header("Retry-After").toInt() * 1000;
+        }
+    }
+    client.end(); // a 304 has no body, so the connection stays open
+    return code;
+}
+
+void http_cache_end(HTTPClient &client, HttpCache_t *cache, HttpFetchStats_t *stats, uint32_t body_bytes,
+                    bool whole_body) {
+    stats->bytes_received += body_bytes;
+    cache->etag = client.header("ETag");
+    cache->last_modified = client.header("Last-Modified");
+    cache->checked_ms = millis();
+    cache->max_age_ms = response_max_age_ms(client);
+    cache->body_bytes = client.getSize() >= 0 ? client.getSize() : whole_body ? (int32_t)body_bytes : -1;
+    cache->valid = true;
+    if (!whole_body) client.getStream().stop(); // the rest is not wanted: drop it with the connection
+    client.end();
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// HttpBodyStream
+// ----------------------------------------------------------------------------------------------------------
+HttpBodyStream::HttpBodyStream(HTTPClient &client) : source(client.getStream()) {
+    chunked = !strcasecmp(client.header("Transfer-Encoding").c_str(), "chunked");
+    remaining = chunked ? 0 : client.getSize();
+    start_ms = millis();
+    body_ms = body_timeout_ms;
+    setTimeout(0); // reads wait on the connection already; -1 means the body has ended
+}
+
+// End the body early
+int HttpBodyStream::fail(bool timeout) {
+    ended = cut_short = true;
+    timed_out = timeout;
+    return -1;
+}
+
+// Read the size line of the next chunk (after the end of the one before); false after the last
+bool HttpBodyStream::next_chunk() {
+    if (ended) return false;
+    if (started) source.readStringUntil('\n');
+    started = true;
+    String line = source.readStringUntil('\n');
+    if (line.length() == 0) {
+        fail(false);
+        return false;
+    }
+    remaining = strtol(line.c_str(), NULL, 16);
+    if (remaining <= 0) {
+        source.readStringUntil('\n'); // the blank line after the last chunk
+        remaining = 0;
+        ended = true;
+        return false;
+    }
+    return true;
+}
+
+int HttpBodyStream::next_byte() {
+    if (ended) return -1;
+    if (body_ms > 0 && millis() - start_ms >= body_ms) return fail(true);
+    if (chunked && remaining == 0 && !next_chunk()) return -1;
+    if (remaining == 0) return -1;
+    uint8_t c;
+    if (source.readBytes(&c, 1) != 1) {
+        if (remaining < 0 && !chunked) {
+            ended = true; // no length given: the body ends with the connection
+            return -1;
+        }
+        return fail(false); // timed out, or the connection closed
+    }
+    if (remaining > 0) remaining--;
+    return c;
+}
+
+int HttpBodyStream::available() {
+    if (held >= 0) return 1;
+    if (atEnd()) return 0;
+    int n = source.available();
+    return (!chunked && remaining >= 0 && n > remaining) ? remaining : n;
+}
+
+int HttpBodyStream::read() {
+    int c = held >= 0 ? held : next_byte();
+    held = -1;
+    if (c >= 0) bytes_read++;
+    return c;
+}
+
+int HttpBodyStream::peek() {
+    if (held < 0) held = next_byte();
+    return held;
+}
+
+bool HttpBodyStream::atEnd() const {
+    return held < 0 && !cut_short && (ended || (!chunked && remaining == 0));
+}
@@ -0,0 +1,91 @@
+#ifndef _JVDW_HTTP_CACHE_H
+#define _JVDW_HTTP_CACHE_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Conditional requests over a kept-alive connection
+//
+// Each weather refresh asks the same host for two resources, one after the other. One HTTPClient is used for
+// both with connection reuse on and HTTP/1.1, so the second request goes out on the connection the first one
+// opened (a request whose body is fully read leaves the connection ready for the next; one that is only read
+// in part closes it).
+//
+// Per resource, the validators of the last full response are kept (ETag, Last-Modified) together with how
+// long it may be used without asking again (Cache-Control: max-age, less any Age). While that lasts no request
+// is sent at all; after it, the request carries If-None-Match / If-Modified-Since and a 304 answer means what
+// was parsed last time is still current, so the caller has nothing to read or parse.
+//
+// With HTTP/1.1 the server may send the body chunked; HttpBodyStream gives the body as a plain stream either
+// way, bounded by its length so a parser reading on never waits for bytes of the next response, and by a
+// deadline for all of it, so a server that trickles the body out cannot hold the caller for long.
+// ----------------------------------------------------------------------------------------------------------
+struct HttpCache_t
+{
+    String etag, last_modified; // validators of the last full response, empty if it had none
+    uint32_t checked_ms = 0;    // millis() of the last 200 or 304
+    uint32_t max_age_ms = 0;    // how long after that the response may be used without asking; 0: ask every time
+    int32_t body_bytes = -1;    // size of the last full response's body, if known
+    bool valid = false;         // a full response has been read
+};
+
+struct HttpFetchStats_t
+{
+    uint32_t requests;     // sent
+    uint32_t connections;  // opened for a request
+    uint32_t reused;       // requests sent on a connection left open by the one before
+    uint32_t not_modified; // 304 answers
+    uint32_t fresh;        // requests not sent, the last response still being fresh
+    uint32_t errors;       // connection failures, and answers other than 200 or 304
+    uint32_t bytes_received, bytes_saved; // of bodies: read, and not sent again thanks to a 304 or freshness
+    uint32_t retry_after_ms; // asked for by the last answer (a 429 or 503 with Retry-After), 0 if none
+};
+
+// The limits of every request: to connect, to wait for each read, and for the whole body once the headers
+// are in (0: no limit but the one on each read)
+void http_cache_set_timeouts(HTTPClient &client, int32_t connect_ms, uint16_t read_ms, uint32_t body_ms);
+
+// Ask for url unless the cached response is still fresh, conditionally if there are validators. Returns
+// HTTP_CODE_OK when there is a new body to read (then read it and call http_cache_end), HTTP_CODE_NOT_MODIFIED
+// when what was read last time is still current (whether or not a request was sent), or else the status or
+// the client's (negative) error; in those cases the request has been ended already.
+int http_cache_get(HTTPClient &client, const String &url, HttpCache_t *cache, HttpFetchStats_t *stats);
+
+// Finish with a 200 from http_cache_get, having read body_bytes of it: all of it if whole_body, in which case
+// the connection stays open for the next request, or else part of it and the connection is closed. The
+// response's validators are kept; if the body turned out to be of no use, reset the cache afterwards
+// (*cache = HttpCache_t()) so the next request asks for all of it again.
+void http_cache_end(HTTPClient &client, HttpCache_t *cache, HttpFetchStats_t *stats, uint32_t body_bytes,
+                    bool whole_body);
+
+// The body of the response to the last http_cache_get, with any chunked transfer encoding taken off and
+// ending where the body ends, or at the body deadline. Reads block for up to the connection's timeout.
+class HttpBodyStream : public Stream {
+public:
+    HttpBodyStream(HTTPClient &client);
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t) override { return 0; }
+
+    uint32_t bytesRead() const { return bytes_read; }
+    bool atEnd() const;                       // the whole body is known to have been read
+    bool failed() const { return cut_short; } // it ended early: timed out, or the connection closed
+    bool timedOut() const { return timed_out; }
+
+private:
+    bool next_chunk();
+    int next_byte();
+    int fail(bool timeout);
+
+    Stream &source;
+    bool chunked;
+    int32_t remaining; // of the body, or of the current chunk if chunked; -1 if not known
+    bool started = false, ended = false, cut_short = false, timed_out = false;
+    uint32_t start_ms, body_ms;
+    int held = -1; // a byte peeked at
+    uint32_t bytes_read = 0;
+};
+
+#endif // _JVDW_HTTP_CACHE_H
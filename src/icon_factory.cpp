@@ -1,92 +1,72 @@
 #include <Arduino.h>
 
-#include <Adafruit_GFX.h>
-
-#include <math.h>
-
+#include "aa_raster.h"
 #include "image_tools.h"
+#include "weather_icon.h"
 
 uint16_t colour_565_sun = COLOR565(255, 237, 128); // light yellow
 
+// Handlers draw straight onto the final size with the anti-aliased primitives; the centre and radius are
+// in aa_raster fixed point, t is the animation phase in turns
 struct IconDrawInfo_t
 {
-    GFXcanvas16 *canvas;
+    AASurface_t surface;
     int16_t w, h;
-    int16_t cx, cy;
+    int32_t cx, cy, r;
     uint8_t daytime;
     float t;
 };
 
-struct IconDrawFunction
-{
-    String code;
-    void (*handler)(IconDrawInfo_t *);
-};
+typedef void (*IconDrawHandler_t)(IconDrawInfo_t *);
 
 void ClearSky(IconDrawInfo_t *info);
 
-IconDrawFunction icon_handler_map[] = {
-    {"01", &ClearSky},
-    {"", NULL}};
-
-void DrawWeatherIcon(String icon_name, GFXcanvas16 *canvas, float t) {
-    String icon_code = icon_name.substring(0, 2);
-    uint8_t daytime = icon_name.endsWith("d") ? 1 : 0;
-    uint8_t i = 0;
+// Procedural handler of each weather kind (NULL: not drawn procedurally yet)
+constexpr IconDrawHandler_t ICON_HANDLERS[WEATHER_ICON_KINDS] = {
+    ClearSky, // IconClearSky
+    NULL,     // IconFewClouds
+    NULL,     // IconScatteredClouds
+    NULL,     // IconBrokenClouds
+    NULL,     // IconShowerRain
+    NULL,     // IconRain
+    NULL,     // IconThunderstorm
+    NULL,     // IconSnow
+    NULL      // IconMist
+};
 
-    // clear the canvas
+// Draw an icon onto a cleared w x h buffer; returns false if the icon has no procedural handler
+bool DrawWeatherIcon(WeatherIcon_t code, uint16_t *pixels, int16_t w, int16_t h, float t) {
     IconDrawInfo_t info = {
-        .canvas = canvas,
-        .w = canvas->width(),
-        .h = canvas->height(),
-        .cx = (int16_t)(canvas->width() >> 1),
-        .cy = (int16_t)(canvas->height() >> 1),
-        .daytime = daytime,
+        .surface = {pixels, w, h},
+        .w = w,
+        .h = h,
+        .cx = AA_ONE * (w - 1) / 2,
+        .cy = AA_ONE * (h - 1) / 2,
+        .r = AA_ONE * min(w, h) / 2,
+        .daytime = !weather_icon_night(code),
         .t = t};
-    memset(canvas->getBuffer(), 0, info.w * info.h * 2);
-    while (icon_handler_map[i].handler != NULL) {
-        // Serial.printf("[%s] vs [%s]", icon_handler_map[i].code.c_str(), icon_code.c_str());
-        if (icon_handler_map[i].code == icon_code) {
-            // Serial.printf(" -- MATCH!!\n");
-            icon_handler_map[i].handler(&info);
-            break;
-        }
-        // Serial.printf("\n");
-        i++;
-    }
+    memset(pixels, 0, w * h * sizeof(uint16_t));
+    if (!weather_icon_valid(code) || ICON_HANDLERS[weather_icon_kind(code)] == NULL) return false;
+    ICON_HANDLERS[weather_icon_kind(code)](&info);
+    return true;
 }
 
 // ----------------------------------------------------------------------------------------------------------------------
 // 01: Clear Sky
 // ----------------------------------------------------------------------------------------------------------------------
 void ClearSkyDay(IconDrawInfo_t *info) {
-    int16_t r_outer = min(info->w, info->h) / 2, r_inner = r_outer / 2, r_mid = r_inner + 4, l = r_outer - r_mid;
-    int16_t d_mid = r_mid * M_SQRT1_2, d_outer = r_outer * M_SQRT1_2;
-    // Serial.printf("cx=[%d], cy=[%d], --> r_outer=[%d], r_mid=[%d], r_inner=[%d]\n", info->cx, info->cy, r_outer, r_mid, r_inner);
+    int32_t r_outer = info->r, r_inner = r_outer / 2, r_mid = r_inner + r_outer / 8;
 
-    info->canvas->drawCircle(info->cx, info->cy, r_inner, colour_565_sun);
-    info->canvas->drawCircle(info->cx, info->cy, r_inner - 1, colour_565_sun);
-    float t = info->t * M_PI * 2.0f;
-    for (uint8_t a = 0; a < 8; a++) {
-        float tt = t;
-        for (uint8_t v = 0; v < 2; v++) {
-            float cos = cosf(tt), sin = sinf(tt);
-            int16_t dx_mid = cos * r_mid, dy_mid = sin * r_mid, dx_outer = cos * r_outer, dy_outer = sin * r_outer;
-            // Serial.printf(" ... dx_mid=[%d], dy_mid=[%d], dx_outer=[%d], dy_outer=[%d]\n", dx_mid, dy_mid, dx_outer, dy_outer);
-            info->canvas->drawLine(info->cx + dx_mid, info->cy + dy_mid, info->cx + dx_outer, info->cy + dy_outer, colour_565_sun);
-            tt += (2.0f * M_PI / 100.0f);
-        }
-        t += (2.0f * M_PI / 8.0f);
-    }
+    // the disc's edge, 1/16 of the radius wide
+    aa_circle(&info->surface, info->cx, info->cy, r_inner - r_outer / 64, r_outer / 16, colour_565_sun);
 
-    // info->canvas->drawFastHLine(info->cx + r_mid, info->cy, l, colour_565_sun);
-    // info->canvas->drawFastHLine(info->cx - r_mid, info->cy, -l, colour_565_sun);
-    // info->canvas->drawFastVLine(info->cx, info->cy + r_mid, l, colour_565_sun);
-    // info->canvas->drawFastVLine(info->cx, info->cy + r_mid, -l, colour_565_sun);
-    // info->canvas->drawLine(info->cx + d_mid, info->cy + d_mid, info->cx + d_outer, info->cy + d_outer, colour_565_sun);
-    // info->canvas->drawLine(info->cx - d_mid, info->cy + d_mid, info->cx - d_outer, info->cy + d_outer, colour_565_sun);
-    // info->canvas->drawLine(info->cx - d_mid, info->cy - d_mid, info->cx - d_outer, info->cy - d_outer, colour_565_sun);
-    // info->canvas->drawLine(info->cx + d_mid, info->cy - d_mid, info->cx + d_outer, info->cy - d_outer, colour_565_sun);
+    // 8 one pixel wide rays
+    uint16_t angle = (uint32_t)(info->t * AA_TURN) + AA_TURN / 200;
+    for (uint8_t a = 0; a < 8; a++, angle += AA_TURN / 8) {
+        int32_t cos = aa_cos(angle), sin = aa_sin(angle);
+        aa_line(&info->surface, info->cx + cos * r_mid / AA_TRIG_ONE, info->cy + sin * r_mid / AA_TRIG_ONE,
+                info->cx + cos * r_outer / AA_TRIG_ONE, info->cy + sin * r_outer / AA_TRIG_ONE, colour_565_sun);
+    }
 }
 void ClearSkyNight(IconDrawInfo_t *info) {
 }
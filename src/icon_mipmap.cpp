@@ -0,0 +1,48 @@
+#include <Arduino.h>
+
+#include <JvdW_RGB565Kernels.h>
+
+#include "icon_mipmap.h"
+
+bool icon_mipmap_build(IconMipmap_t *mipmap, const uint16_t *pixels, uint16_t w, uint16_t h, const uint8_t *scales, uint8_t count) {
+    mipmap->levels = 0;
+    if (pixels == NULL) return false;
+    mipmap->level[mipmap->levels++] = {w, h, 1, pixels};
+
+    bool ok = true;
+    for (uint8_t i = 0; i < count && mipmap->levels < ICON_MIPMAP_MAX_LEVELS; i++) {
+        uint8_t scale = scales[i];
+        uint16_t lw = w / scale, lh = h / scale; // always samples LESS or EQUAL size from the original
+        if (scale < 2 || lw == 0 || lh == 0) continue;
+        size_t bytes = (size_t)lw * lh * sizeof(uint16_t);
+        uint16_t *level = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+        if (level == NULL) level = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_DEFAULT);
+        if (level == NULL) {
+            ok = false;
+            continue;
+        }
+        RGB565.downscale(pixels, w, level, lw, lh, scale);
+        mipmap->level[mipmap->levels++] = {lw, lh, scale, level};
+    }
+    return ok;
+}
+
+const IconLevel_t *icon_mipmap_fit(const IconMipmap_t *mipmap, uint16_t max_w, uint16_t max_h) {
+    const IconLevel_t *best = NULL;
+    for (uint8_t i = 0; i < mipmap->levels; i++) {
+        const IconLevel_t *l = &mipmap->level[i];
+        bool fits = l->w <= max_w && l->h <= max_h;
+        bool best_fits = best != NULL && best->w <= max_w && best->h <= max_h;
+        if (best == NULL || (fits && (!best_fits || l->w > best->w)) || (!fits && !best_fits && l->w < best->w)) {
+            best = l;
+        }
+    }
+    return best;
+}
+
+const IconLevel_t *icon_mipmap_scale(const IconMipmap_t *mipmap, uint8_t scale) {
+    for (uint8_t i = 0; i < mipmap->levels; i++) {
+        if (mipmap->level[i].scale == scale) return &mipmap->level[i];
+    }
+    return NULL;
+}
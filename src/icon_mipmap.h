@@ -0,0 +1,36 @@
+#ifndef _JVDW_ICON_MIPMAP_H
+#define _JVDW_ICON_MIPMAP_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Icon pyramid: box-filtered copies of an icon at integer reductions (1/2, 1/3, ...), built once when the
+// icon is loaded so that drawing an icon at a smaller size never resamples. Level pixels are at full
+// brightness, like the icon they come from.
+// ----------------------------------------------------------------------------------------------------------
+#define ICON_MIPMAP_MAX_LEVELS 4
+
+struct IconLevel_t
+{
+    uint16_t w, h;
+    uint8_t scale; // 1/scale of the original
+    const uint16_t *pixels;
+};
+
+struct IconMipmap_t
+{
+    uint8_t levels;
+    IconLevel_t level[ICON_MIPMAP_MAX_LEVELS]; // level 0 is the original, the others follow in scale order
+};
+
+// Build the pyramid of an icon for the given reductions (level 0, the original, is always included and
+// shares its pixels); returns false if a level could not be allocated
+bool icon_mipmap_build(IconMipmap_t *mipmap, const uint16_t *pixels, uint16_t w, uint16_t h, const uint8_t *scales, uint8_t count);
+
+// The largest level that fits in max_w x max_h (the smallest one if none does); NULL for an empty pyramid
+const IconLevel_t *icon_mipmap_fit(const IconMipmap_t *mipmap, uint16_t max_w, uint16_t max_h);
+
+// The level built for exactly 1/scale, NULL if there is none
+const IconLevel_t *icon_mipmap_scale(const IconMipmap_t *mipmap, uint8_t scale);
+
+#endif // _JVDW_ICON_MIPMAP_H
@@ -0,0 +1,99 @@
+#include <Arduino.h>
+
+#include "icon_sheet.h"
+
+static size_t sheet_bytes(const IconSheetCache_t *cache, uint16_t size) {
+    return (size_t)cache->frames * size * size * sizeof(uint16_t);
+}
+
+static void free_sheet(IconSheetCache_t *cache, IconSheet_t *sheet) {
+    heap_caps_free(sheet->pixels);
+    cache->bytes -= sheet_bytes(cache, sheet->size);
+    memset(sheet, 0, sizeof(*sheet));
+}
+
+void icon_sheet_begin(IconSheetCache_t *cache, IconSheetRender_t render, uint8_t frames, size_t cap_bytes) {
+    memset(cache, 0, sizeof(*cache));
+    cache->render = render;
+    cache->frames = frames > ICON_SHEET_MAX_FRAMES ? ICON_SHEET_MAX_FRAMES : frames;
+    cache->cap_bytes = cap_bytes;
+}
+
+void icon_sheet_clear(IconSheetCache_t *cache) {
+    for (uint8_t i = 0; i < ICON_SHEET_MAX_SHEETS; i++) {
+        if (cache->sheet[i].pixels) free_sheet(cache, &cache->sheet[i]);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Find the sheet of code at size, or make room for it and allocate it; NULL if it doesn't fit
+// ----------------------------------------------------------------------------------------------------------
+static IconSheet_t *find_sheet(IconSheetCache_t *cache, WeatherIcon_t code, uint16_t size) {
+    for (uint8_t i = 0; i < ICON_SHEET_MAX_SHEETS; i++) {
+        IconSheet_t *sheet = &cache->sheet[i];
+        if (sheet->pixels && sheet->code == code && sheet->size == size) return sheet;
+    }
+
+    size_t needed = sheet_bytes(cache, size);
+    if (needed > cache->cap_bytes) return NULL;
+    while (true) {
+        IconSheet_t *empty = NULL, *oldest = NULL;
+        for (uint8_t i = 0; i < ICON_SHEET_MAX_SHEETS; i++) {
+            IconSheet_t *sheet = &cache->sheet[i];
+            if (sheet->pixels == NULL) {
+                if (empty == NULL) empty = sheet;
+            } else if (oldest == NULL || (int32_t)(sheet->last_used - oldest->last_used) < 0) {
+                oldest = sheet;
+            }
+        }
+        if (empty && cache->bytes + needed <= cache->cap_bytes) {
+            empty->pixels = (uint16_t *)heap_caps_malloc(needed, MALLOC_CAP_SPIRAM);
+            if (empty->pixels == NULL) empty->pixels = (uint16_t *)heap_caps_malloc(needed, MALLOC_CAP_DEFAULT);
+            if (empty->pixels == NULL) return NULL;
+            empty->code = code;
+            empty->size = size;
+            empty->ready = 0;
+            cache->bytes += needed;
+            cache->stats.sheet_allocs++;
+            return empty;
+        }
+        if (oldest == NULL) return NULL;
+        free_sheet(cache, oldest);
+        cache->stats.evictions++;
+    }
+}
+
+const uint16_t *icon_sheet_frame(IconSheetCache_t *cache, WeatherIcon_t code, uint16_t size, uint8_t frame,
+                                 const BrightnessTable_t *table, uint32_t epoch) {
+    IconSheet_t *sheet = (weather_icon_valid(code) && frame < cache->frames) ? find_sheet(cache, code, size) : NULL;
+    if (sheet == NULL) {
+        cache->stats.failures++;
+        return NULL;
+    }
+    sheet->last_used = ++cache->clock;
+    if (sheet->epoch != epoch) {
+        sheet->ready = 0;
+        sheet->epoch = epoch;
+    }
+
+    uint16_t *pixels = sheet->pixels + (size_t)frame * size * size;
+    if (sheet->ready & (1UL << frame)) {
+        cache->stats.hits++;
+        return pixels;
+    }
+
+    uint32_t start_us = micros();
+    if (!cache->render(code, frame, cache->frames, size, pixels)) {
+        cache->stats.failures++;
+        return NULL;
+    }
+    brightness_scale_buffer(table, pixels, pixels, size * size);
+    sheet->ready |= 1UL << frame;
+
+    uint32_t render_us = micros() - start_us;
+    cache->stats.frame_renders++;
+    cache->stats.last_render_us = render_us;
+    cache->stats.total_render_us += render_us;
+    if (render_us > cache->stats.max_render_us) cache->stats.max_render_us = render_us;
+    return pixels;
+}
@@ -0,0 +1,70 @@
+#ifndef _JVDW_ICON_SHEET_H
+#define _JVDW_ICON_SHEET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "brightness.h"
+#include "weather_icon.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Sprite-sheet cache of animated weather icons
+//
+// A sheet holds every frame of one icon code (kind and day/night) at one size, at the brightness of one
+// lookup table epoch. A sheet is allocated the first time its code is asked for, and each frame is drawn
+// the first time it is needed, so the cost is spread over the first loop of the animation. After that,
+// animating an icon is a lookup and a blit.
+//
+// The sheets live in PSRAM, up to a byte cap: when a new sheet would go over it (or every slot is taken),
+// the least recently used sheets are freed first. A sheet whose epoch is out of date keeps its memory and
+// redraws its frames as they are asked for.
+// ----------------------------------------------------------------------------------------------------------
+#define ICON_SHEET_MAX_SHEETS 8
+#define ICON_SHEET_MAX_FRAMES 32
+
+// Draw frame of frames of an icon at full brightness into dest (size x size); returns false if it can't
+typedef bool (*IconSheetRender_t)(WeatherIcon_t code, uint8_t frame, uint8_t frames, uint16_t size, uint16_t *dest);
+
+struct IconSheet_t
+{
+    WeatherIcon_t code;
+    uint16_t size;
+    uint32_t epoch;     // brightness table epoch the ready frames were drawn with
+    uint16_t *pixels;   // frames * size * size, NULL for an empty slot
+    uint32_t ready;     // bit per frame drawn
+    uint32_t last_used; // cache clock at the last lookup
+};
+
+struct IconSheetStats_t
+{
+    uint32_t hits;          // frame lookups that were a blit
+    uint32_t frame_renders; // frame lookups that had to draw the frame
+    uint32_t sheet_allocs;
+    uint32_t evictions;
+    uint32_t failures; // lookups that got no frame (no memory, or the icon could not be drawn)
+    uint32_t last_render_us, max_render_us, total_render_us;
+};
+
+struct IconSheetCache_t
+{
+    IconSheetRender_t render;
+    uint8_t frames;
+    size_t cap_bytes; // PSRAM the sheets may use together
+    size_t bytes;     // PSRAM they use now
+    uint32_t clock;
+    IconSheet_t sheet[ICON_SHEET_MAX_SHEETS];
+    IconSheetStats_t stats;
+};
+
+// Set up an empty cache of sheets with the given number of frames (at most ICON_SHEET_MAX_FRAMES)
+void icon_sheet_begin(IconSheetCache_t *cache, IconSheetRender_t render, uint8_t frames, size_t cap_bytes);
+
+// A frame of an icon at the brightness of table, drawn now if needed; NULL if the icon is unknown, can't
+// be drawn, or there is no memory for its sheet
+const uint16_t *icon_sheet_frame(IconSheetCache_t *cache, WeatherIcon_t code, uint16_t size, uint8_t frame,
+                                 const BrightnessTable_t *table, uint32_t epoch);
+
+// Free every sheet
+void icon_sheet_clear(IconSheetCache_t *cache);
+
+#endif // _JVDW_ICON_SHEET_H
@@ -0,0 +1,105 @@
+#include <Arduino.h>
+
+#include "lane_strip.h"
+
+bool lane_strip_begin(LaneStrip_t *lane, GFXcanvas16 *canvas) {
+    memset(lane, 0, sizeof(*lane));
+    lane->canvas = canvas;
+    lane->pixels = (uint16_t *)malloc(canvas->width() * canvas->height() * sizeof(uint16_t));
+    return lane->pixels != NULL;
+}
+
+void lane_strip_add_segment(LaneStrip_t *lane, int16_t x, uint16_t w, LaneSegmentDraw_t draw) {
+    if (lane->segment_count >= LANE_MAX_SEGMENTS) return;
+    LaneSegment_t &s = lane->segment[lane->segment_count++];
+    s.x = x;
+    s.w = w;
+    s.draw = draw;
+    s.valid = false;
+    s.dimmed = false;
+}
+
+void lane_strip_set_key(LaneStrip_t *lane, uint8_t segment, uint32_t key) {
+    LaneSegment_t &s = lane->segment[segment];
+    if (s.key != key) {
+        s.key = key;
+        s.valid = false;
+    }
+}
+
+void lane_strip_invalidate(LaneStrip_t *lane) {
+    for (uint8_t i = 0; i < lane->segment_count; i++) {
+        lane->segment[i].valid = false;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Dim columns [x, x + w) of every row of the strip
+// ----------------------------------------------------------------------------------------------------------
+static void dim_columns(LaneStrip_t *lane, int16_t x, uint16_t w, const BrightnessTable_t *table) {
+    uint16_t W = lane->canvas->width(), H = lane->canvas->height();
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (x + w > W) w = W - x;
+    const uint16_t *source = lane->canvas->getBuffer() + x;
+    uint16_t *dest = lane->pixels + x;
+    for (uint16_t y = 0; y < H; y++) {
+        brightness_scale_buffer(table, source, dest, w);
+        source += W;
+        dest += W;
+    }
+}
+
+void lane_strip_prepare(LaneStrip_t *lane, const BrightnessTable_t *table, uint32_t epoch) {
+    uint16_t H = lane->canvas->height();
+    for (uint8_t i = 0; i < lane->segment_count; i++) {
+        LaneSegment_t &s = lane->segment[i];
+        if (!s.valid) {
+            lane->canvas->fillRect(s.x, 0, s.w, H, 0);
+            s.draw(lane->canvas);
+            s.valid = true;
+            s.dimmed = false;
+            lane->stats.segment_renders++;
+        }
+    }
+
+    if (lane->epoch != epoch) {
+        dim_columns(lane, 0, lane->canvas->width(), table);
+        for (uint8_t i = 0; i < lane->segment_count; i++) {
+            lane->segment[i].dimmed = true;
+        }
+        lane->epoch = epoch;
+        lane->stats.full_dims++;
+        return;
+    }
+
+    for (uint8_t i = 0; i < lane->segment_count; i++) {
+        LaneSegment_t &s = lane->segment[i];
+        if (!s.dimmed) {
+            dim_columns(lane, s.x, s.w, table);
+            s.dimmed = true;
+            lane->stats.segment_dims++;
+        }
+    }
+}
+
+void lane_strip_blit(const LaneStrip_t *lane, int16_t left_x, GFXcanvas16 *dest, int16_t y) {
+    int16_t W = lane->canvas->width(), H = lane->canvas->height(), DW = dest->width();
+    int16_t row0 = max((int16_t)0, (int16_t)-y), row1 = min(H, (int16_t)(dest->height() - y));
+    left_x %= W;
+    if (left_x < 0) left_x += W;
+    for (int16_t row = row0; row < row1; row++) {
+        const uint16_t *source = lane->pixels + row * W;
+        uint16_t *out = dest->getBuffer() + (y + row) * DW;
+        int16_t x = left_x, remaining = DW;
+        while (remaining > 0) {
+            int16_t n = min(remaining, (int16_t)(W - x));
+            memcpy(out, source + x, n * sizeof(uint16_t));
+            out += n;
+            remaining -= n;
+            x = 0;
+        }
+    }
+}
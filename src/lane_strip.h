@@ -0,0 +1,66 @@
+#ifndef _JVDW_LANE_STRIP_H
+#define _JVDW_LANE_STRIP_H
+
+#include <Adafruit_GFX.h>
+
+#include "brightness.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Cached scrolling lane
+//
+// A lane is a wide strip made of fixed-width segments (temperature, wind, ... ), each drawn by its own
+// callback. Every segment carries a key describing what it shows (e.g. the value it prints); a segment is
+// only re-rendered when its key changes, and the brightness-adjusted copy of the strip that is blitted to
+// the matrix is only recomputed for re-rendered segments, or entirely when the brightness table changes.
+//
+// The strip is circular: the screen shows the columns from left_x on, wrapping round to column 0 past the
+// end, so each row is copied in (at most) two contiguous pieces rather than clipping the whole strip.
+// ----------------------------------------------------------------------------------------------------------
+#define LANE_MAX_SEGMENTS 4
+
+typedef void (*LaneSegmentDraw_t)(GFXcanvas16 *canvas);
+
+struct LaneSegment_t
+{
+    int16_t x;
+    uint16_t w;
+    LaneSegmentDraw_t draw;
+    uint32_t key;   // what the segment was (or is to be) rendered from
+    uint8_t valid;  // rendered into the canvas with the current key
+    uint8_t dimmed; // brightness-adjusted copy up to date
+};
+
+struct LaneStripStats_t
+{
+    uint32_t segment_renders;
+    uint32_t segment_dims;
+    uint32_t full_dims;
+};
+
+struct LaneStrip_t
+{
+    GFXcanvas16 *canvas; // full brightness strip
+    uint16_t *pixels;    // brightness-adjusted strip, same size as canvas
+    uint32_t epoch;      // brightness table epoch the adjusted strip was made with
+    uint8_t segment_count;
+    LaneSegment_t segment[LANE_MAX_SEGMENTS];
+    LaneStripStats_t stats;
+};
+
+// Attach a lane to its (already allocated) canvas; returns false if the adjusted copy can't be allocated
+bool lane_strip_begin(LaneStrip_t *lane, GFXcanvas16 *canvas);
+void lane_strip_add_segment(LaneStrip_t *lane, int16_t x, uint16_t w, LaneSegmentDraw_t draw);
+
+// Set what a segment shows; the segment is re-rendered on the next prepare if the key changed
+void lane_strip_set_key(LaneStrip_t *lane, uint8_t segment, uint32_t key);
+
+// Force every segment to re-render (e.g. its colours changed)
+void lane_strip_invalidate(LaneStrip_t *lane);
+
+// Render the stale segments and bring the adjusted strip up to date with the brightness table
+void lane_strip_prepare(LaneStrip_t *lane, const BrightnessTable_t *table, uint32_t epoch);
+
+// Copy the adjusted strip into rows y.. of dest (unrotated), starting at strip column left_x and wrapping
+void lane_strip_blit(const LaneStrip_t *lane, int16_t left_x, GFXcanvas16 *dest, int16_t y);
+
+#endif // _JVDW_LANE_STRIP_H
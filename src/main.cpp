@@ -15,6 +15,7 @@ or "doublebuffer" for animation basics.
 #include <Adafruit_Protomatter.h> // For RGB matrix
 
 #include <JvdW_ImageReader.h>
+#include <JvdW_RGB565Kernels.h>
 
 #include <WiFi.h>
 #include <HTTPClient.h>
@@ -27,6 +28,24 @@ or "doublebuffer" for animation basics.
 
 #include "secrets.h"
 #include "image_tools.h"
+#include "compositor.h"
+#include "frame_scheduler.h"
+#include "lane_strip.h"
+#include "brightness.h"
+#include "subpixel_sprite.h"
+#include "psram_canvas.h"
+#include "forecast_panel.h"
+#include "icon_mipmap.h"
+#include "weather_icon.h"
+#include "icon_sheet.h"
+#include "frame_pipeline.h"
+#include "screen_transition.h"
+#include "output_stage.h"
+#include "span_font.h"
+#include "fast_blit.h"
+#include "http_cache.h"
+#include "forecast_ingest.h"
+#include "weather_fetch.h"
 
 // ----------------------------------------------------------------------------------------------------------
 // LittleFS (was SPIFFS)
@@ -40,7 +59,16 @@ or "doublebuffer" for animation basics.
 // ----------------------------------------------------------------------------------------------------------
 #define SCREEN_HEIGHT 64 // Matrix height (pixels) - SET TO 64 FOR 64x64 MATRIX!
 #define SCREEN_WIDTH 64  // Matrix width (pixels)
-#define MAX_FPS 45       // Maximum redraw rate, frames/second
+#define MAX_FPS 45       // Animation tick rate (and so maximum redraw rate), frames/second
+#define MAX_CATCHUP_TICKS 4
+// #define REPORT_FRAME_BUDGET
+#define ICON_SUBPIXEL_PHASES 16 // Pre-rendered sub-pixel positions of the bouncing icon (power of 2, 1..128)
+#define RENDER_PIPELINE_DEPTH 2 // Frames queued between composing (loop, core 1) and pushing (core 0); 0 = serial
+#define RENDER_PUSH_CORE 0
+#define RENDER_PUSH_PRIORITY 3 // above the weather and light sensor tasks
+#define OUTPUT_STAGE            // Compose at full brightness; apply brightness, gamma and dithering on the way to the panel
+#define OUTPUT_DITHER OutputDitherOrdered
+#define OUTPUT_GAMMA_X100 100 // 100: linear, as the colours were chosen
 
 #if defined(_VARIANT_MATRIXPORTAL_M4_) // MatrixPortal M4
 uint8_t rgbPins[] = {7, 8, 9, 10, 11, 12};
@@ -68,9 +96,10 @@ Adafruit_Protomatter matrix(
     SCREEN_WIDTH, 5, 1, rgbPins, NUM_ADDR_PINS, addrPins,
     clockPin, latchPin, oePin, true);
 
-Adafruit_LIS3DH accel = Adafruit_LIS3DH();
+GFXcanvas16 *screen = &matrix; // where the frames are composed: the matrix, or the frame pipeline's back canvas
+SpanFont_t text_font;          // the GFX font as runs, for drawing text into canvases
 
-uint32_t prevTime = 0; // Used for frames-per-second throttle
+Adafruit_LIS3DH accel = Adafruit_LIS3DH();
 
 // ----------------------------------------------------------------------------------------------------------
 // Light sensor
@@ -79,6 +108,7 @@ uint32_t prevTime = 0; // Used for frames-per-second throttle
 #define LIGHT_SENSOR_MIN_R 500
 #define LIGHT_SENSOR_MAX_R 2500
 #define LIGHT_SENSOR_R_SERIES 1200
+#define LIGHT_SENSOR_HYSTERESIS 6 // brightness steps (of 256) the filtered reading must move to rebuild the table
 
 // ----------------------------------------------------------------------------------------------------------
 // Wifi
@@ -103,7 +133,9 @@ const int daylightOffset_sec = 0;
 #include "example_json.h"
 
 #if !defined(SIMULATE_CURRENT_WEATHER_API) || !defined(SIMULATE_WEATHER_FORECAST_API)
-HTTPClient client;
+HTTPClient client; // one kept-alive connection for both requests of a refresh
+HttpCache_t current_cache, forecast_cache;
+HttpFetchStats_t http_stats = {};
 #endif
 
 // Use cityname, country code where countrycode is ISO3166 format.
@@ -114,12 +146,18 @@ String FULL_LOCATION = LOCATION + ",AU";
 String openweather_token = OPENWEATHER_TOKEN;
 String UNITS = "metric"; // can pick 'imperial' or 'metric' as part of URL query
 const uint32_t WEATHER_INTERVAL_MIN = 10;
+const int32_t FETCH_CONNECT_MS = 5000; // deadlines of each weather request: to connect,
+const uint16_t FETCH_READ_MS = 5000;   // for the status and each header or body read,
+const uint32_t FETCH_BODY_MS = 10000;  // and for the whole body
 
 const uint32_t CURRENT_WEATHER_DISPLAY_TIME_MS = 30 * 1000, FORECAST_WEATHER_DISPLAY_TIME_MS = 10 * 1000;
 uint64_t next_swap_time = 0;
+const TransitionKind TRANSITION_TO_FORECAST = TransitionSlide, TRANSITION_TO_CURRENT = TransitionCrossfade;
+const uint16_t TRANSITION_TICKS = MAX_FPS * 2 / 3; // two thirds of a second
+ScreenTransition_t screen_transition;
 
 float CURRENT_TEMP, CURRENT_WIND, CURRENT_HUMIDITY;
-String CURRENT_ICON;
+WeatherIcon_t CURRENT_ICON = WEATHER_ICON_NONE;
 
 //  Set up from where we'll be fetching data
 // https://openweathermap.org/current
@@ -127,29 +165,19 @@ String CURRENT_WEATHER_URL = "http://api.openweathermap.org/data/2.5/weather?q="
 // https://openweathermap.org/forecast5
 String FORECAST_WEATHER_URL = "http://api.openweathermap.org/data/2.5/forecast?q=" + FULL_LOCATION + "&units=" + UNITS + "&appid=" + openweather_token;
 
-const uint8_t ICON_COUNT = 9, INDICATOR_COUNT_TOP = 3, INDICATOR_COUNT_BOTTOM = 2;
+const uint8_t ICON_COUNT = WEATHER_ICON_KINDS, INDICATOR_COUNT_TOP = 3, INDICATOR_COUNT_BOTTOM = 2;
 Adafruit_ImageReader img_reader(LittleFS);
 Adafruit_Image img, icon[ICON_COUNT][2], ind_top[INDICATOR_COUNT_TOP], *current_icon = NULL, *previous_icon = NULL;
-String icon_names[ICON_COUNT] = {
-    "01",
-    "02", // "few clouds"
-    "03", // "scattered clouds"
-    "04", // "broken clouds"
-    "09", // "shower rain"
-    "10", // "rain"
-    "11", // "thunderstorm"
-    "13", // "snow"
-    "50"  // "mist"
-};
+IconMipmap_t icon_mipmap[ICON_COUNT][2];      // icon[kind][night] and its reduced copies
+const uint8_t ICON_MIPMAP_SCALES[] = {2, 3}; // reductions built when the icons are loaded
 
-extern void DrawWeatherIcon(String icon_name, GFXcanvas16 *canvas, float t);
+extern bool DrawWeatherIcon(WeatherIcon_t code, uint16_t *pixels, int16_t w, int16_t h, float t);
 // #define TEST_WEATHER_ICONS
-const uint8_t WEATHER_ICON_SCALE = 2;
 const uint8_t WEATHER_ICON_SIZE = SCREEN_HEIGHT / 2;
-const uint8_t WEATHER_ICON_CANVAS_SIZE = WEATHER_ICON_SCALE * WEATHER_ICON_SIZE;
 const uint8_t WEATHER_ICON_STEPS = 16;
+const size_t ICON_SHEET_PSRAM_CAP = 256 * 1024; // 8 sheets of 16 frames at 32x32
 
-uint16_t *externalMemory[WEATHER_ICON_STEPS] = {0};
+IconSheetCache_t icon_sheets; // animation frames of the icons, drawn as they are first shown
 
 uint8_t showing_forecast = true;
 uint8_t valid_forecasts = 0;
@@ -157,7 +185,7 @@ uint8_t valid_forecasts = 0;
 struct ForecastInfo_t
 {
     float temp, wind;
-    String icon;
+    WeatherIcon_t icon;
     uint8_t hour;
 };
 
@@ -218,9 +246,35 @@ const uint8_t IND_WIDTH = 8, IND_HEIGHT = 10;
 const uint16_t CANVAS_Y_TOP = 0, CANVAS_Y_BOTTOM = SCREEN_HEIGHT - 1 - IND_HEIGHT;
 
 uint16_t text_colour_565_time, text_colour_565_temperature, text_colour_565_wind;
+uint16_t text_colour_565_stale, text_colour_565_missing; // of the location, when the weather is out of date
+
+GFXcanvas16 *top_canvas, *bottom_canvas, *middle_canvas;
+GFXcanvas16 *colon_canvas;       // the blinking colon of the clock, drawn over the bottom lane
+uint16_t colon_pixels[5 * 7];    // colon_canvas at the current brightness
+uint8_t colon_alpha[5 * 7];      // where colon_canvas is lit
+LaneStrip_t top_lane, bottom_lane; // rendered (and dimmed) copies of the top and bottom canvas
+int16_t time_colon_x = 0;         // x of the colon within the bottom canvas
+// The brightness lookup is double-buffered: light_sensor_task builds the back table and loop() swaps it in
+// between two frames, so a frame never sees a half-built table
+struct BrightnessLookupStats_t
+{
+    uint32_t rebuilds, swaps;
+    uint32_t last_build_us, max_build_us;
+};
 
-GFXcanvas16 *top_canvas, *bottom_canvas, *middle_canvas, weather_icon_canvas(WEATHER_ICON_CANVAS_SIZE, WEATHER_ICON_CANVAS_SIZE);
-uint16_t lookup[65536];
+BrightnessTable_t lookup_tables[2];
+BrightnessTable_t *lookup = &lookup_tables[0], *lookup_back = &lookup_tables[1];
+uint16_t lookup_bri = 0;                 // brightness the front table was built for
+volatile uint16_t lookup_back_bri = 0;   // brightness the back table was built for
+volatile uint8_t lookup_pending = false; // back table built and waiting to be swapped in
+volatile uint32_t lookup_epoch = 0;      // bumped every time the lookup table changes
+BrightnessLookupStats_t lookup_stats = {0};
+#if defined(OUTPUT_STAGE)
+// with the output stage the table stays at full brightness, and the output stage is double-buffered instead
+OutputStage_t output_stages[2];
+OutputStage_t *output_stage = &output_stages[0], *output_stage_back = &output_stages[1];
+#endif
+volatile uint32_t weather_version = 0; // bumped every time weather_task has fetched new data
 
 // ----------------------------------------------------------------------------------------------------------
 // Error indicator
@@ -255,15 +309,57 @@ void animate_wait(void *p) {
 }
 
 // ----------------------------------------------------------------------------------------------------------
-// Dim a 16-bit canvas into the provided buffer
+// Build the back brightness lookup table for a brightness of bri/256 (nothing happens while the previous
+// one is still waiting to be swapped in)
 // ----------------------------------------------------------------------------------------------------------
-void dimCanvas16(const GFXcanvas16 *canvas16, uint16_t *buffer) {
-    uint16_t *source = canvas16->getBuffer();
-    uint32_t N = canvas16->width() * canvas16->height();
-    for (uint32_t ti = 0; ti < N; ti++) {
-        (*buffer++) = lookup[(*source++)];
-    }
+void build_brightness_lookup(uint16_t bri) {
+    if (lookup_pending) return;
+    uint32_t start_us = micros();
+#if defined(OUTPUT_STAGE)
+    output_stage_set(output_stage_back, bri, OUTPUT_GAMMA_X100, OUTPUT_DITHER);
+#else
+    brightness_build(lookup_back, bri);
+#endif
+    lookup_stats.last_build_us = micros() - start_us;
+    if (lookup_stats.last_build_us > lookup_stats.max_build_us) lookup_stats.max_build_us = lookup_stats.last_build_us;
+    lookup_stats.rebuilds++;
+    lookup_back_bri = bri;
+    lookup_pending = true;
+}
+
+// Scale a single colour to the current brightness
+inline uint16_t dim565(uint16_t c) {
+    return brightness_scale(lookup, c);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Swap in a freshly built lookup table; only to be called between frames
+// ----------------------------------------------------------------------------------------------------------
+bool swap_brightness_lookup() {
+    if (!lookup_pending) return false;
+#if defined(OUTPUT_STAGE)
+    OutputStage_t *front = output_stage;
+    output_stage = output_stage_back;
+    output_stage_back = front;
+#else
+    BrightnessTable_t *front = lookup;
+    lookup = lookup_back;
+    lookup_back = front;
+    lookup_epoch++;
+#endif
+    lookup_bri = lookup_back_bri;
+    lookup_stats.swaps++;
+    lookup_pending = false;
+    return true;
+}
+
+#if defined(OUTPUT_STAGE)
+// Frame pipeline output: the composed frame through the output stage into the matrix
+void panel_output(const uint16_t *frame, uint16_t *panel) {
+    static uint32_t frame_count = 0;
+    output_stage_565(output_stage, frame, panel, SCREEN_WIDTH, SCREEN_HEIGHT, frame_count++);
 }
+#endif
 
 // ----------------------------------------------------------------------------------------------------------
 // Light sensor reading task
@@ -277,18 +373,16 @@ void light_sensor_task(void *p) {
         delay(50);
         uint16_t newValue = analogRead(LIGHT_SENSOR_PIN);
         ldrValue = (k * ldrValue + newValue) >> k_bits;
-        uint16_t i = 0, bri = (ldrValue >> 3);
+        uint16_t bri = (ldrValue >> 3);
         if (bri > 256) bri = 256;
         if (bri < 48) bri = 48;
         // Serial.printf("ldrV=[%d], bri=[%d]\n", ldrValue, bri);
-        for (uint16_t r = 0; r < 32; r++) {
-            for (uint16_t g = 0; g < 64; g++) {
-                for (uint16_t b = 0; b < 32; b++) {
-                    uint16_t rr = (r * bri) >> 8, gg = (g * bri) >> 8, bb = (b * bri) >> 8;
-                    lookup[i++] = (rr << 11) | (gg << 5) | bb;
-                }
-                yield();
-            }
+
+        // only rebuild when the reading has clearly moved (or reached either end of the range), so sensor
+        // noise doesn't keep rebuilding the table
+        uint16_t current = lookup_pending ? lookup_back_bri : lookup_bri;
+        if (bri != current && (abs(bri - current) >= LIGHT_SENSOR_HYSTERESIS || bri == 48 || bri == 256)) {
+            build_brightness_lookup(bri);
         }
     }
 }
@@ -316,14 +410,11 @@ void initTime() {
 // ----------------------------------------------------------------------------------------------------------
 void get_weather_icon() {
     current_icon = NULL;
-    String icon_code = CURRENT_ICON.substring(0, 2);
-    Serial.printf("CURRENT_ICON:[%s]\n", CURRENT_ICON.c_str());
-    for (uint8_t i = 0; i < ICON_COUNT; i++) {
-        if (icon_code == icon_names[i]) {
-            current_icon = &icon[i][CURRENT_ICON.endsWith("n") ? 1 : 0];
-            Serial.printf("MATCH!\n");
-            return;
-        }
+    Serial.printf("CURRENT_ICON:[%s%c]\n", weather_icon_stem(CURRENT_ICON), weather_icon_suffix(CURRENT_ICON));
+    if (weather_icon_valid(CURRENT_ICON)) {
+        current_icon = &icon[weather_icon_kind(CURRENT_ICON)][weather_icon_night(CURRENT_ICON)];
+        Serial.printf("MATCH!\n");
+        return;
     }
     Serial.printf("NO MATCH!\n");
 }
@@ -331,68 +422,131 @@ void get_weather_icon() {
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Get current weather update
 // ----------------------------------------------------------------------------------------------------------
-void get_current_weather() {
+// nothing is stored unless the response was a 200 whose fields are all there
+WeatherFetchResult get_current_weather(uint32_t *retry_after_ms) {
     JsonDocument doc;
 #if defined(SIMULATE_CURRENT_WEATHER_API)
+    (void)retry_after_ms;
     deserializeJson(doc, JSON_CURRENT_WEATHER);
 #else
     Serial.printf("%s\n", CURRENT_WEATHER_URL.c_str());
-    client.begin(CURRENT_WEATHER_URL);
-    client.GET();
-    String response = client.getString();
+    int code = http_cache_get(client, CURRENT_WEATHER_URL, &current_cache, &http_stats);
+    if (code == HTTP_CODE_NOT_MODIFIED) return FetchUnchanged;
+    if (code != HTTP_CODE_OK) {
+        Serial.printf("Current weather request failed: [%d] %s\n", code, HTTPClient::errorToString(code).c_str());
+        *retry_after_ms = http_stats.retry_after_ms;
+        return FetchFailed;
+    }
+    HttpBodyStream body(client);
+    String response = body.readString();
+    http_cache_end(client, &current_cache, &http_stats, body.bytesRead(), body.atEnd());
     Serial.printf("%s\n", response.c_str());
-    deserializeJson(doc, response.c_str());
+    DeserializationError error = body.failed() ? DeserializationError::IncompleteInput
+                                               : deserializeJson(doc, response.c_str());
+    if (error || !doc["main"]["temp"].is<float>() || !doc["main"]["humidity"].is<float>() ||
+        !doc["wind"]["speed"].is<float>() || !doc["weather"][0]["icon"].is<const char *>()) {
+        Serial.printf("Current weather unusable: [%s]%s\n", error.c_str(), body.timedOut() ? " timed out" : "");
+        current_cache = HttpCache_t();
+        return FetchFailed;
+    }
 #endif
     CURRENT_TEMP = doc["main"]["temp"];
     CURRENT_WIND = doc["wind"]["speed"];
     CURRENT_WIND *= 3.6f;
     CURRENT_HUMIDITY = doc["main"]["humidity"];
-    CURRENT_ICON = (String)doc["weather"][0]["icon"];
+    CURRENT_ICON = weather_icon_parse(doc["weather"][0]["icon"].as<const char *>());
+    return FetchUpdated;
 }
 
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Get weather foreacst update
 // ----------------------------------------------------------------------------------------------------------
-void get_weather_forecast() {
-    JsonDocument doc;
+// the entries are parsed straight off the connection, and only as many as are shown; they are stored only
+// when there are enough of them
+WeatherFetchResult get_weather_forecast(uint32_t *retry_after_ms) {
+    ForecastEntry_t entries[MAX_FORECASTS];
+    ForecastIngestStats_t stats;
 #if defined(SIMULATE_WEATHER_FORECAST_API)
-    deserializeJson(doc, JSON_FORECAST_WEATHER);
+    (void)retry_after_ms;
+    CStringStream response(JSON_FORECAST_WEATHER);
+    forecast_stats_start(&stats);
+    forecast_ingest(response, entries, MAX_FORECASTS, &stats);
 #else
     Serial.printf("%s\n", FORECAST_WEATHER_URL.c_str());
-    client.begin(FORECAST_WEATHER_URL);
-    client.GET();
-    String response = client.getString();
-    Serial.printf("%s\n", response.c_str());
-    deserializeJson(doc, response.c_str());
+    int code = forecast_fetch(client, FORECAST_WEATHER_URL, &forecast_cache, &http_stats, entries, MAX_FORECASTS, &stats);
+    if (code == HTTP_CODE_NOT_MODIFIED) return FetchUnchanged;
+    if (code != HTTP_CODE_OK) {
+        Serial.printf("Forecast request failed: [%d] %s\n", code, HTTPClient::errorToString(code).c_str());
+        *retry_after_ms = http_stats.retry_after_ms;
+        return FetchFailed;
+    }
 #endif
-    JsonArray forecasts = doc["list"];
-    uint8_t forecasts_size = forecasts.size();
-    Serial.printf("FORECASTS = [%d]\n", forecasts_size);
+    Serial.printf("FORECASTS = [%d] parse=[%uus] heap=[%u free before, %u peak use] error=[%s]\n", stats.entries,
+                  stats.parse_us, stats.heap_before, stats.heap_before - stats.heap_low, stats.error.c_str());
+    if (!forecast_complete(&stats, MAX_FORECASTS)) return FetchFailed; // keep showing the last forecast
     valid_forecasts = 0;
-    for (uint8_t i = 0; i < MAX_FORECASTS && i < forecasts_size; i++, valid_forecasts++) {
-        current_forecast[i].temp = forecasts[i]["main"]["temp"];
-        current_forecast[i].wind = forecasts[i]["wind"]["speed"];
-        current_forecast[i].icon = (String)(forecasts[i]["weather"][0]["icon"]);
-        time_t unixTimestamp = forecasts[i]["dt"];
+    for (uint8_t i = 0; i < stats.entries; i++, valid_forecasts++) {
+        current_forecast[i].temp = entries[i].temp;
+        current_forecast[i].wind = entries[i].wind;
+        current_forecast[i].icon = entries[i].icon;
         // Convert UTC time to Melbourne time
-        time_t melbourneTime = Melbourne.toLocal(unixTimestamp);
+        time_t melbourneTime = Melbourne.toLocal(entries[i].dt);
         current_forecast[i].hour = hour(melbourneTime);
-        Serial.printf("-- FORECAST[%d]=[%02dH:%.1fC, %.1fm/s, %s]\n", i, current_forecast[i].hour, current_forecast[i].temp, current_forecast[i].wind, current_forecast[i].icon.c_str());
+        Serial.printf("-- FORECAST[%d]=[%02dH:%.1fC, %.1fm/s, %s%c]\n", i, current_forecast[i].hour, current_forecast[i].temp, current_forecast[i].wind,
+                      weather_icon_stem(current_forecast[i].icon), weather_icon_suffix(current_forecast[i].icon));
     }
+    return FetchUpdated;
+}
+
+WeatherFetchResult fetch_current_weather(uint32_t *retry_after_ms) {
+    WeatherFetchResult result = get_current_weather(retry_after_ms);
+    if (result == FetchUpdated) get_weather_icon();
+    return result;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Weather task: runs the fetch state machine
+// ----------------------------------------------------------------------------------------------------------
+WeatherFetch_t weather_fetch;
+
+void weather_fetch_setup() {
+    weather_fetch_begin(&weather_fetch, WEATHER_INTERVAL_MIN * 60 * 1000);
+    // current weather first: its body is read whole, so the forecast request goes out on its connection
+    weather_fetch_add_step(&weather_fetch, fetch_current_weather);
+    weather_fetch_add_step(&weather_fetch, get_weather_forecast);
+}
+
+// what the display shows of how current the weather is
+WeatherStaleness weather_staleness() {
+    return weather_fetch_staleness(&weather_fetch, millis());
 }
 
 TaskHandle_t task_weather;
 void weather_task(void *) {
-    const uint32_t WEATHER_INTERVAL_MS = WEATHER_INTERVAL_MIN * 60 * 1000;
-    uint64_t next_check = 0;
+    weather_fetch_setup();
     while (1) {
-        uint64_t now = millis();
-        if (now > next_check) {
-            next_check += WEATHER_INTERVAL_MS;
+        uint32_t runs = weather_fetch.step_runs;
+        if (weather_fetch.state == FetchIdle && millis() - weather_fetch.refresh_ms >= weather_fetch.interval_ms) {
             Serial.printf("Getting weather for %s\n", FULL_LOCATION.c_str());
-            get_current_weather();
-            get_weather_icon();
-            get_weather_forecast();
+        }
+        if (weather_fetch_poll(&weather_fetch, millis())) weather_version++;
+        if (weather_fetch.step_runs != runs) {
+            Serial.printf("FETCH: state=[%d] step=[%d] failures=[%u in a row, %u total] retries=[%u] skipped=[%u] "
+                          "step=[%ums, max %ums]",
+                          weather_fetch.state, weather_fetch.step, weather_fetch.failures_in_row, weather_fetch.step_failures,
+                          weather_fetch.retries, weather_fetch.steps_skipped, weather_fetch.last_step_us / 1000,
+                          weather_fetch.max_step_us / 1000);
+            if (weather_fetch.state == FetchBackoff) {
+                Serial.printf(weather_fetch.attempts ? " retry in [%ums]" : " next step in [%ums]",
+                              (uint32_t)(weather_fetch.wait_until_ms - millis()));
+            }
+            Serial.printf("\n");
+#if !defined(SIMULATE_CURRENT_WEATHER_API) || !defined(SIMULATE_WEATHER_FORECAST_API)
+            Serial.printf("HTTP: requests=[%u] connections=[%u] reused=[%u] not_modified=[%u] fresh=[%u] errors=[%u] "
+                          "bytes=[%u received, %u saved]\n",
+                          http_stats.requests, http_stats.connections, http_stats.reused, http_stats.not_modified,
+                          http_stats.fresh, http_stats.errors, http_stats.bytes_received, http_stats.bytes_saved);
+#endif
         }
         delay(100);
     }
@@ -406,17 +560,15 @@ void display_indicator(GFXcanvas16 *canvas, const char *format, float value, Top
 
     char temp_buffer[16];
     snprintf(temp_buffer, sizeof(temp_buffer), format, value);
-    uint16_t pixels = 3 * strlen(temp_buffer) + IND_WIDTH / 2 + 1;
+    uint16_t pixels = span_text_width(&text_font, temp_buffer) / 2 + IND_WIDTH / 2 + 1;
 
     left_x -= pixels;
 
     if (ind_top[indicator_index].canvas.canvas16)
-        canvas->drawRGBBitmap(left_x, 0, ind_top[indicator_index].canvas.canvas16->getBuffer(), IND_WIDTH, IND_HEIGHT);
+        blit_rgb565(canvas, left_x, 0, ind_top[indicator_index].canvas.canvas16->getBuffer(), IND_WIDTH, IND_HEIGHT);
     left_x += IND_WIDTH + 2;
 
-    canvas->setCursor(left_x, OFFSET_TEXT_TOP_Y);
-    canvas->setTextColor(text_colour_565);
-    canvas->printf(temp_buffer);
+    span_text_draw(&text_font, canvas, left_x, OFFSET_TEXT_TOP_Y, temp_buffer, text_colour_565);
 }
 
 void display_temperature(GFXcanvas16 *canvas) {
@@ -437,28 +589,40 @@ void display_wind(GFXcanvas16 *canvas) {
 // METHOD: Display the Humidity
 // ----------------------------------------------------------------------------------------------------------
 void display_humidity(GFXcanvas16 *canvas) {
-    display_indicator(canvas, "%.0f%%%%", CURRENT_HUMIDITY, IndHumidity, matrix.color565(128, 192, 255)); // cyanish
+    display_indicator(canvas, "%.0f%%", CURRENT_HUMIDITY, IndHumidity, matrix.color565(128, 192, 255)); // cyanish
 }
 
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Display the Time
 // ----------------------------------------------------------------------------------------------------------
+time_t local_time() {
+    // Convert UTC time to Melbourne time
+    time_t now;
+    time(&now);
+    return Melbourne.toLocal(now);
+}
+
+bool time_colon_visible() {
+    return (millis() % 1000) > 350;
+}
+
+void format_time(char *buffer, size_t size, char separator) {
+    time_t melbourneTime = local_time();
+    snprintf(buffer, size, "%02d%c%02d", hour(melbourneTime), separator, minute(melbourneTime));
+}
+
+// the time segment of the bottom lane is rendered without its colon, which blinks as a separate overlay
 void display_time(GFXcanvas16 *canvas) {
     uint8_t indicator_index = (uint8_t)IndTime, left_x = SCREEN_WIDTH / 2 + indicator_info_bottom[indicator_index].x;
 
-    // Convert UTC time to Melbourne time
     char temp_buffer[16];
-    time_t now;
-    time(&now);
-    time_t melbourneTime = Melbourne.toLocal(now);
-    snprintf(temp_buffer, sizeof(temp_buffer), "%02d%c%02d", hour(melbourneTime), (millis() % 1000) > 350 ? ':' : ' ', minute(melbourneTime));
-    uint16_t pixels = 3 * strlen(temp_buffer);
+    format_time(temp_buffer, sizeof(temp_buffer), ' ');
+    uint16_t pixels = span_text_width(&text_font, temp_buffer) / 2;
 
     left_x -= pixels;
+    time_colon_x = left_x + span_text_width(&text_font, "00");
 
-    canvas->setCursor(left_x, OFFSET_TEXT_BOTTOM_Y);
-    canvas->setTextColor(matrix.color565(255, 255, 255)); // white
-    canvas->printf(temp_buffer);
+    span_text_draw(&text_font, canvas, left_x, OFFSET_TEXT_BOTTOM_Y, temp_buffer, matrix.color565(255, 255, 255)); // white
 }
 
 // ----------------------------------------------------------------------------------------------------------
@@ -470,9 +634,9 @@ void display_location(GFXcanvas16 *canvas) {
     char temp_buffer[16];
     snprintf(temp_buffer, sizeof(temp_buffer), "%s", LOCATION.c_str());
 
-    canvas->setCursor(left_x, OFFSET_TEXT_BOTTOM_Y);
-    canvas->setTextColor(text_colour_565_time); // green
-    canvas->printf(temp_buffer);
+    // green while the weather is current, amber once a refresh has been missed, red until there is any
+    const uint16_t colours[] = {text_colour_565_time, text_colour_565_stale, text_colour_565_missing};
+    span_text_draw(&text_font, canvas, left_x, OFFSET_TEXT_BOTTOM_Y, temp_buffer, colours[weather_staleness()]);
 }
 
 // ----------------------------------------------------------------------------------------------------------
@@ -480,32 +644,101 @@ void display_location(GFXcanvas16 *canvas) {
 // ----------------------------------------------------------------------------------------------------------
 int16_t icon_x = 0;
 const uint16_t icon_bits = 7, icon_mod = (1 << icon_bits);
+SubpixelSprite_t icon_sprite = {0};
+
+// the pre-rendered phase closest to (below) the icon's sub-pixel position
+uint8_t icon_phase() {
+    return (icon_x % icon_mod) * ICON_SUBPIXEL_PHASES / icon_mod;
+}
 uint8_t icon_direction = 1;
 
-void display_current_weather() {
-    if (previous_icon != current_icon) {
-        previous_icon = current_icon;
-    }
+// Compositor element ids
+enum ScreenElement {
+    ElemIcon = 0,
+    ElemTopLane,
+    ElemBottomLane,
+    ElemTimeColon,
+    ElemForecastPanel
+};
+
+// Layers of the current weather screen; their pixels are the cached sprite phase and colon
+CompositorLayer_t icon_layer = {0}, colon_layer = {0};
+uint32_t icon_layer_epoch = 0, colon_layer_epoch = 0;
+const Adafruit_Image *icon_layer_image = NULL;
+
+void draw_weather_icon(uint8_t) {
     if (previous_icon != NULL) {
-        uint8_t k0 = (icon_x % icon_mod), k1 = icon_mod - k0;
         uint16_t W = previous_icon->width(), H = previous_icon->height();
-        uint16_t bmp[W * H];
-        memset(bmp, 0, W * H * 2);
-        uint16_t *icon_buffer = previous_icon->canvas.canvas16->getBuffer();
-        for (uint8_t y = 0; y < previous_icon->height() - 1; y++) {
-            for (uint8_t x = 0; x < previous_icon->width() - 1; x++) {
-                uint16_t c0 = icon_buffer[y * W + x], c1 = icon_buffer[y * W + x + 1];
-                uint16_t r0 = (c0 >> 11), g0 = (c0 >> 5) & 0x3F, b0 = c0 & 0x1F;
-                uint16_t r1 = (c1 >> 11), g1 = (c1 >> 5) & 0x3F, b1 = c1 & 0x1F;
-                r0 = ((r0 * k0 + r1 * k1) >> icon_bits) << 11;
-                g0 = ((g0 * k0 + g1 * k1) >> icon_bits) << 5;
-                b0 = (b0 * k0 + b1 * k1) >> icon_bits;
-                bmp[y * W + x + 1] = lookup[r0 | g0 | b0];
-            }
+        subpixel_sprite_set(&icon_sprite, previous_icon->canvas.canvas16->getBuffer(), W, H, ICON_SUBPIXEL_PHASES);
+        const uint16_t *bmp = subpixel_sprite_phase(&icon_sprite, icon_phase(), lookup, lookup_epoch);
+        if (bmp != NULL) {
+            blit_rgb565(screen, icon_x >> icon_bits, 32 - H / 2, bmp, W, H);
+        } else {
+            // no room to keep the phases: render this one for this frame only
+            uint16_t temp[W * H];
+            subpixel_sprite_render(&icon_sprite, icon_phase(), lookup, temp);
+            blit_rgb565(screen, icon_x >> icon_bits, 32 - H / 2, temp, W, H);
         }
-        // matrix.drawRGBBitmap(32 - previous_icon->width() / 2, 32 - previous_icon->height() / 2, previous_icon->canvas.canvas16->getBuffer(), previous_icon->width(), previous_icon->height());
-        matrix.drawRGBBitmap(icon_x >> icon_bits, 32 - H / 2, bmp, W, H);
+    }
+}
 
+// ----------------------------------------------------------------------------------------------------------
+// Lane segments are keyed on what they show, so the text is only rendered again when that changes
+// ----------------------------------------------------------------------------------------------------------
+uint32_t float_key(float value) {
+    uint32_t key;
+    memcpy(&key, &value, sizeof(key));
+    return key;
+}
+
+void update_lane_keys() {
+    lane_strip_set_key(&top_lane, IndTemperature, float_key(CURRENT_TEMP));
+    lane_strip_set_key(&top_lane, IndWind, float_key(CURRENT_WIND));
+    lane_strip_set_key(&top_lane, IndHumidity, float_key(CURRENT_HUMIDITY));
+    time_t t = local_time();
+    lane_strip_set_key(&bottom_lane, IndTime, hour(t) * 60 + minute(t));
+    lane_strip_set_key(&bottom_lane, IndLocation, weather_staleness());
+}
+
+void draw_top_lane(uint8_t) {
+    update_lane_keys();
+    lane_strip_prepare(&top_lane, lookup, lookup_epoch);
+    lane_strip_blit(&top_lane, indicator_left_x_top, screen, CANVAS_Y_TOP);
+}
+
+void draw_time_colon(int16_t x) {
+    if (x <= -colon_canvas->width() || x >= SCREEN_WIDTH) return;
+    const uint16_t *source = colon_canvas->getBuffer();
+    for (int16_t y = 0; y < colon_canvas->height(); y++) {
+        for (int16_t i = 0; i < colon_canvas->width(); i++) {
+            uint16_t c = *source++;
+            if (c) screen->drawPixel(x + i, CANVAS_Y_BOTTOM + OFFSET_TEXT_BOTTOM_Y + y, dim565(c));
+        }
+    }
+}
+
+void draw_time_colons() {
+    if (time_colon_visible()) {
+        draw_time_colon(time_colon_x - indicator_left_x_bottom);
+        draw_time_colon(time_colon_x - indicator_left_x_bottom + total_w_bottom);
+    }
+}
+
+void draw_bottom_lane(uint8_t) {
+    update_lane_keys();
+    lane_strip_prepare(&bottom_lane, lookup, lookup_epoch);
+    lane_strip_blit(&bottom_lane, indicator_left_x_bottom, screen, CANVAS_Y_BOTTOM);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Advance the icon and the scrolling lanes of the current weather screen
+// ----------------------------------------------------------------------------------------------------------
+void update_current_weather() {
+    if (previous_icon != current_icon) {
+        previous_icon = current_icon;
+    }
+    if (previous_icon != NULL) {
+        uint16_t W = previous_icon->width();
         if (icon_direction) {
             icon_x++;
             if (icon_x == ((63 - W) * icon_mod) - 1) {
@@ -549,149 +782,244 @@ void display_current_weather() {
             }
         }
     }
+}
 
-    // erase the top canvas
-    top_canvas->fillRect(0, 0, total_w_top, IND_HEIGHT, 0);
-    // display the scrolling items in the top lane. they each check if they are in view before rendering anything
-    display_temperature(top_canvas);
-    display_wind(top_canvas);
-    display_humidity(top_canvas);
-    uint16_t temp_top[total_w_top * IND_HEIGHT];
-    dimCanvas16(top_canvas, (uint16_t *)&temp_top);
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Track the elements of the current weather screen with the compositor
+// ----------------------------------------------------------------------------------------------------------
+void track_current_weather() {
+    uint32_t epoch = lookup_epoch, sig;
 
-    matrix.drawRGBBitmap(-indicator_left_x_top, CANVAS_Y_TOP, (uint16_t *)&temp_top, total_w_top, IND_HEIGHT);
-    if (indicator_left_x_top >= (total_w_top - SCREEN_WIDTH)) {
-        matrix.drawRGBBitmap(total_w_top - indicator_left_x_top, CANVAS_Y_TOP, (uint16_t *)&temp_top, total_w_top, IND_HEIGHT);
+    if (previous_icon != NULL) {
+        int16_t W = previous_icon->width(), H = previous_icon->height();
+        subpixel_sprite_set(&icon_sprite, previous_icon->canvas.canvas16->getBuffer(), W, H, ICON_SUBPIXEL_PHASES);
+        const uint16_t *bmp = subpixel_sprite_phase(&icon_sprite, icon_phase(), lookup, lookup_epoch);
+        if (bmp != NULL) {
+            // the icon is a layer over the phase it's at; its black surround is see-through
+            icon_layer.dirty |= icon_layer_epoch != epoch || icon_layer_image != previous_icon;
+            icon_layer_epoch = epoch;
+            icon_layer_image = previous_icon;
+            icon_layer.pixels = bmp;
+            icon_layer.x = icon_x >> icon_bits;
+            icon_layer.y = 32 - H / 2;
+            icon_layer.w = icon_layer.stride = W;
+            icon_layer.h = H;
+            icon_layer.opacity = 256;
+            icon_layer.blend = BlendLuma;
+            compositor_track_layer(ElemIcon, &icon_layer);
+        } else {
+            const Adafruit_Image *icon_ptr = previous_icon;
+            sig = compositor_hash(COMPOSITOR_HASH_SEED, &icon_ptr, sizeof(icon_ptr));
+            // the icon only looks different when it moves to another pixel or phase
+            uint16_t position[2] = {(uint16_t)(icon_x >> icon_bits), icon_phase()};
+            sig = compositor_hash(sig, position, sizeof(position));
+            sig = compositor_hash(sig, &epoch, sizeof(epoch));
+            compositor_track(ElemIcon, {(int16_t)(icon_x >> icon_bits), (int16_t)(32 - H / 2), W, H}, sig, draw_weather_icon);
+        }
     }
 
-    // erase the bottom canvas
-    bottom_canvas->fillRect(0, 0, total_w_bottom, IND_HEIGHT, 0);
-    // display the scrolling items in the bottom lane. they each check if they are in view before rendering anything
-    display_time(bottom_canvas);
-    display_location(bottom_canvas);
-    uint16_t temp_bottom[total_w_bottom * IND_HEIGHT];
-    dimCanvas16(bottom_canvas, (uint16_t *)&temp_bottom);
-    matrix.drawRGBBitmap(-indicator_left_x_bottom, CANVAS_Y_BOTTOM, (uint16_t *)&temp_bottom, total_w_bottom, IND_HEIGHT);
-    if (indicator_left_x_bottom >= (total_w_bottom - SCREEN_WIDTH)) {
-        matrix.drawRGBBitmap(total_w_bottom - indicator_left_x_bottom, CANVAS_Y_BOTTOM, (uint16_t *)&temp_bottom, total_w_bottom, IND_HEIGHT);
+    float values[INDICATOR_COUNT_TOP] = {CURRENT_TEMP, CURRENT_WIND, CURRENT_HUMIDITY};
+    sig = compositor_hash(COMPOSITOR_HASH_SEED, values, sizeof(values));
+    sig = compositor_hash(sig, &indicator_left_x_top, sizeof(indicator_left_x_top));
+    sig = compositor_hash(sig, &epoch, sizeof(epoch));
+    compositor_track(ElemTopLane, {0, (int16_t)CANVAS_Y_TOP, SCREEN_WIDTH, IND_HEIGHT}, sig, draw_top_lane);
+
+    time_t t = local_time();
+    uint16_t clock[2] = {(uint16_t)(hour(t) * 60 + minute(t)), weather_staleness()};
+    sig = compositor_hash(COMPOSITOR_HASH_SEED, clock, sizeof(clock));
+    sig = compositor_hash(sig, &indicator_left_x_bottom, sizeof(indicator_left_x_bottom));
+    sig = compositor_hash(sig, &epoch, sizeof(epoch));
+    compositor_track(ElemBottomLane, {0, (int16_t)CANVAS_Y_BOTTOM, SCREEN_WIDTH, IND_HEIGHT}, sig, draw_bottom_lane);
+
+    // the colon blinks on its own layer over the lane, at whichever of its two positions is on screen
+    if (time_colon_visible()) {
+        if (colon_layer_epoch != epoch) {
+            brightness_scale_buffer(lookup, colon_canvas->getBuffer(), colon_pixels, sizeof(colon_pixels) / sizeof(colon_pixels[0]));
+            colon_layer_epoch = epoch;
+            colon_layer.dirty = true;
+        }
+        int16_t x = time_colon_x - indicator_left_x_bottom;
+        if (x <= -colon_canvas->width()) x += total_w_bottom;
+        colon_layer.pixels = colon_pixels;
+        colon_layer.alpha = colon_alpha;
+        colon_layer.x = x;
+        colon_layer.y = CANVAS_Y_BOTTOM + OFFSET_TEXT_BOTTOM_Y;
+        colon_layer.w = colon_layer.stride = colon_canvas->width();
+        colon_layer.h = colon_canvas->height();
+        colon_layer.opacity = 256;
+        colon_layer.blend = BlendAlpha;
+        compositor_track_layer(ElemTimeColon, &colon_layer);
     }
 }
 
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Display the current weather (advance and redraw everything)
+// ----------------------------------------------------------------------------------------------------------
+void display_current_weather() {
+    update_current_weather();
+    draw_weather_icon(0);
+    draw_top_lane(0);
+    draw_bottom_lane(0);
+    draw_time_colons();
+}
+
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Create a scaled version of a canvas/image
 // ----------------------------------------------------------------------------------------------------------
 void scale_down(uint16_t *icon_buffer, uint16_t WW, uint16_t W, uint16_t H, uint16_t *bmp, uint8_t scale) {
-    uint8_t IMG_DIVIDER = scale * scale;
-
-    memset(bmp, 0, W * H * 2);
-    for (uint8_t y = 0; y < H; y++) {
-        for (uint8_t x = 0; x < W; x++) {
-            uint16_t bmp_r = 0, bmp_g = 0, bmp_b = 0;
-            for (uint8_t j = y * scale; j < (y + 1) * scale; j++) {
-                for (uint8_t i = x * scale; i < (x + 1) * scale; i++) {
-                    uint16_t c = icon_buffer[j * WW + i];
-                    uint16_t r = (c >> 11), g = (c >> 5) & 0x3F, b = c & 0x1F;
-                    bmp_r += r;
-                    bmp_g += g;
-                    bmp_b += b;
-                }
-            }
-            bmp_r /= IMG_DIVIDER;
-            bmp_g /= IMG_DIVIDER;
-            bmp_b /= IMG_DIVIDER;
-            bmp[y * W + x] = lookup[(bmp_r << 11) | (bmp_g << 5) | bmp_b];
-        }
-    }
+    RGB565.downscale(icon_buffer, WW, bmp, W, H, scale);
+    brightness_scale_buffer(lookup, bmp, bmp, W * H);
 }
 
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Display the icon scaled
 // ----------------------------------------------------------------------------------------------------------
-void display_scaled_icon(String icon_name, int16_t y, Adafruit_Protomatter *canvas) {
-    Adafruit_Image *forecast_icon = NULL;
-    String icon_code = icon_name.substring(0, 2);
-    for (uint8_t i = 0; i < ICON_COUNT; i++) {
-        if (icon_code == icon_names[i]) {
-            forecast_icon = &icon[i][icon_name.endsWith("n") ? 1 : 0];
-            // Serial.printf("MATCH!\n");
-        }
-    }
+const uint16_t FORECAST_ICON_WIDTH = 16, FORECAST_ICON_HEIGHT = 11; // room for the icon in a forecast row
+
+// The largest version of an icon that fits in max_w x max_h
+const IconLevel_t *get_icon_at_size(WeatherIcon_t code, uint16_t max_w, uint16_t max_h) {
+    if (!weather_icon_valid(code)) return NULL;
+    return icon_mipmap_fit(&icon_mipmap[weather_icon_kind(code)][weather_icon_night(code)], max_w, max_h);
+}
+
+void display_scaled_icon(WeatherIcon_t code, int16_t y, GFXcanvas16 *canvas) {
+    const IconLevel_t *forecast_icon = get_icon_at_size(code, FORECAST_ICON_WIDTH, FORECAST_ICON_HEIGHT);
     if (forecast_icon == NULL) {
-        Serial.printf("NO MATCH! [%s]\n", icon_code.c_str());
+        Serial.printf("NO MATCH! [%02X]\n", code);
         return;
     }
 
-    const uint8_t IMG_SCALE = 3;
-    uint16_t W = forecast_icon->width() / IMG_SCALE, H = forecast_icon->height() / IMG_SCALE; // this will always sample LESS or EQUAL size from original
-    uint16_t WW = forecast_icon->width();
-
+    uint16_t W = forecast_icon->w, H = forecast_icon->h;
     uint16_t bmp[W * H];
-    scale_down(forecast_icon->canvas.canvas16->getBuffer(), WW, W, H, (uint16_t *)&bmp, IMG_SCALE);
+    brightness_scale_buffer(lookup, forecast_icon->pixels, bmp, W * H);
+    blit_rgb565(canvas, 14, y - 2, bmp, W, H);
+}
 
-    // matrix.drawRGBBitmap(32 - previous_icon->width() / 2, 32 - previous_icon->height() / 2, previous_icon->canvas.canvas16->getBuffer(), previous_icon->width(), previous_icon->height());
-    canvas->drawRGBBitmap(14, y - 2, bmp, W, H);
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Animated icons: frames come from the sprite-sheet cache, which draws them with this on first use
+// ----------------------------------------------------------------------------------------------------------
+bool render_icon_frame(WeatherIcon_t code, uint8_t frame, uint8_t frames, uint16_t size, uint16_t *dest) {
+    // one loop of the animation is 1/8 of a turn of t, which the rays of the sun repeat after
+    float t = (float)frame / (frames * 8);
+    if (DrawWeatherIcon(code, dest, size, size, t)) return true;
+
+    // no procedural version yet: every frame is the bitmap, centred
+    const IconLevel_t *level = get_icon_at_size(code, size, size);
+    if (level == NULL || level->w > size || level->h > size) return false;
+    memset(dest, 0, size * size * sizeof(uint16_t));
+    uint16_t *d = dest + ((size - level->h) / 2) * size + (size - level->w) / 2;
+    for (uint16_t y = 0; y < level->h; y++) {
+        memcpy(d + y * size, level->pixels + y * level->w, level->w * sizeof(uint16_t));
+    }
+    return true;
+}
+
+void draw_animated_icon(WeatherIcon_t code, uint8_t frame, int16_t x, int16_t y, uint16_t size, GFXcanvas16 *canvas) {
+    const uint16_t *pixels = icon_sheet_frame(&icon_sheets, code, size, frame % WEATHER_ICON_STEPS, lookup, lookup_epoch);
+    if (pixels) blit_rgb565(canvas, x, y, pixels, size, size);
 }
 
 // ----------------------------------------------------------------------------------------------------------
 // METHOD: Display the forecast weather
 // ----------------------------------------------------------------------------------------------------------
-void display_forecast_weather() {
-    const uint16_t ITEMS_PER_SCREEN = 6;
-    const int16_t FORECAST_ITEM_HEIGHT = SCREEN_HEIGHT / ITEMS_PER_SCREEN;
-    char temp_buffer[16];
-    int16_t pixels, left_x, current_y = 1 + (SCREEN_HEIGHT - ITEMS_PER_SCREEN * FORECAST_ITEM_HEIGHT) / 2;
+const uint16_t ITEMS_PER_SCREEN = 6;
+const int16_t FORECAST_ITEM_HEIGHT = SCREEN_HEIGHT / ITEMS_PER_SCREEN;
 
-    Adafruit_Protomatter *canvas = &matrix;
+int16_t forecast_row_y(uint8_t i) {
+    return 1 + (SCREEN_HEIGHT - ITEMS_PER_SCREEN * FORECAST_ITEM_HEIGHT) / 2 + i * FORECAST_ITEM_HEIGHT;
+}
 
-    for (uint8_t i = 0; i < ITEMS_PER_SCREEN && i < valid_forecasts; i++) {
-        display_scaled_icon(current_forecast[i].icon, current_y, canvas);
-
-        // Time
-        snprintf(temp_buffer, sizeof(temp_buffer), "%2d", current_forecast[i].hour);
-        pixels = 3 * strlen(temp_buffer);
-        left_x = 7 - pixels;
-        canvas->setCursor(left_x, current_y);
-        canvas->setTextColor(lookup[text_colour_565_time]);
-        canvas->printf(temp_buffer);
-
-        // Temperature
-        snprintf(temp_buffer, sizeof(temp_buffer), "%.0f", current_forecast[i].temp);
-        pixels = 3 * strlen(temp_buffer);
-        left_x = 38 - pixels;
-        canvas->setCursor(left_x, current_y);
-        canvas->setTextColor(lookup[text_colour_565_temperature]);
-        canvas->printf(temp_buffer);
-
-        left_x += 2 * pixels;
-        canvas->drawPixel(left_x, current_y, lookup[text_colour_565_temperature]);
-        canvas->drawPixel(left_x + 1, current_y + 1, lookup[text_colour_565_temperature]);
-        canvas->drawPixel(left_x + 2, current_y, lookup[text_colour_565_temperature]);
-        canvas->drawPixel(left_x + 1, current_y - 1, lookup[text_colour_565_temperature]);
-
-        // Wind
-        // snprintf(temp_buffer, sizeof(temp_buffer), "%.0f", 3.6f * current_forecast[i].wind);
-        // pixels = 3 * strlen(temp_buffer);
-        // left_x = 55 - pixels;
-        // canvas->setCursor(left_x, current_y);
-        // canvas->setTextColor(text_colour_565_wind);
-        // canvas->printf(temp_buffer);
-        left_x = 49;
-        const uint8_t bar_w = 13, colour_d = 180 / bar_w;
-        float speed_w = 0, foreacst_w = 3.6f * current_forecast[i].wind;
-        for (uint8_t i = 0; i < bar_w; i++) {
-            uint16_t bar_c = COLOR565(16, 16, 16); // default is a dark grey
-            speed_w += 3.0f;
-            if (foreacst_w > speed_w) {
-                uint8_t R = 64 + (i * colour_d);
-                uint8_t G = 64 + bar_w * colour_d - (i * colour_d);
-                bar_c = lookup[COLOR565(R, G, 64)]; // TO DO - choose a colour
-            }
-            canvas->drawFastVLine(left_x, current_y, 6, bar_c);
-            left_x++;
+void draw_forecast_row(GFXcanvas16 *canvas, uint8_t i) {
+    char temp_buffer[16];
+    int16_t pixels, left_x, current_y = forecast_row_y(i);
+
+    display_scaled_icon(current_forecast[i].icon, current_y, canvas);
+
+    // Time
+    snprintf(temp_buffer, sizeof(temp_buffer), "%2d", current_forecast[i].hour);
+    pixels = span_text_width(&text_font, temp_buffer) / 2;
+    left_x = 7 - pixels;
+    span_text_draw(&text_font, canvas, left_x, current_y, temp_buffer, dim565(text_colour_565_time));
+
+    // Temperature
+    snprintf(temp_buffer, sizeof(temp_buffer), "%.0f", current_forecast[i].temp);
+    pixels = span_text_width(&text_font, temp_buffer) / 2;
+    left_x = 38 - pixels;
+    span_text_draw(&text_font, canvas, left_x, current_y, temp_buffer, dim565(text_colour_565_temperature));
+
+    left_x += 2 * pixels;
+    canvas->drawPixel(left_x, current_y, dim565(text_colour_565_temperature));
+    canvas->drawPixel(left_x + 1, current_y + 1, dim565(text_colour_565_temperature));
+    canvas->drawPixel(left_x + 2, current_y, dim565(text_colour_565_temperature));
+    canvas->drawPixel(left_x + 1, current_y - 1, dim565(text_colour_565_temperature));
+
+    // Wind
+    // snprintf(temp_buffer, sizeof(temp_buffer), "%.0f", 3.6f * current_forecast[i].wind);
+    // pixels = 3 * strlen(temp_buffer);
+    // left_x = 55 - pixels;
+    // canvas->setCursor(left_x, current_y);
+    // canvas->setTextColor(text_colour_565_wind);
+    // canvas->printf(temp_buffer);
+    left_x = 49;
+    const uint8_t bar_w = 13, colour_d = 180 / bar_w;
+    float speed_w = 0, foreacst_w = 3.6f * current_forecast[i].wind;
+    for (uint8_t i = 0; i < bar_w; i++) {
+        uint16_t bar_c = COLOR565(16, 16, 16); // default is a dark grey
+        speed_w += 3.0f;
+        if (foreacst_w > speed_w) {
+            uint8_t R = 64 + (i * colour_d);
+            uint8_t G = 64 + bar_w * colour_d - (i * colour_d);
+            bar_c = dim565(COLOR565(R, G, 64)); // TO DO - choose a colour
         }
+        canvas->drawFastVLine(left_x, current_y, 6, bar_c);
+        left_x++;
+    }
+}
 
-        current_y += FORECAST_ITEM_HEIGHT;
+void display_forecast_weather() {
+    for (uint8_t i = 0; i < ITEMS_PER_SCREEN && i < valid_forecasts; i++) {
+        draw_forecast_row(screen, i);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Forecast panel cache: the rows are rendered into a full-screen surface once per weather update or
+// brightness change, and the surface is blitted while the forecast is on screen
+// ----------------------------------------------------------------------------------------------------------
+PsramCanvas16 *forecast_panel = NULL;
+uint32_t forecast_panel_version = 0, forecast_panel_epoch = 0;
+uint8_t forecast_panel_valid = false;
+ForecastPanelStats_t forecast_panel_stats = {0};
+
+void draw_forecast_panel(uint8_t) {
+    if (forecast_panel == NULL || forecast_panel->getBuffer() == NULL) {
+        display_forecast_weather();
+        return;
+    }
+    uint32_t version = weather_version, epoch = lookup_epoch;
+    if (!forecast_panel_valid || forecast_panel_version != version || forecast_panel_epoch != epoch) {
+        forecast_panel->fillScreen(0);
+        for (uint8_t i = 0; i < ITEMS_PER_SCREEN && i < valid_forecasts; i++) {
+            draw_forecast_row(forecast_panel, i);
+        }
+        forecast_panel_version = version;
+        forecast_panel_epoch = epoch;
+        forecast_panel_valid = true;
+        forecast_panel_stats.misses++;
+    } else {
+        forecast_panel_stats.hits++;
     }
+    blit_canvas(screen, 0, 0, forecast_panel);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Track the forecast screen with the compositor
+// ----------------------------------------------------------------------------------------------------------
+void track_forecast_weather() {
+    uint32_t version = weather_version, epoch = lookup_epoch;
+    uint32_t sig = compositor_hash(COMPOSITOR_HASH_SEED, &version, sizeof(version));
+    sig = compositor_hash(sig, &epoch, sizeof(epoch));
+    compositor_track(ElemForecastPanel, {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT}, sig, draw_forecast_panel);
 }
 
 // ==========================================================================================================
@@ -711,6 +1039,7 @@ void setup(void) {
     ProtomatterStatus status = matrix.begin();
     Serial.printf("Protomatter begin() status: %d\n", status);
     matrix.fillScreen(0x0);
+    if (!span_font_build(&text_font)) Serial.println("Span font: not every glyph fits");
 
 #if defined(TEST_WEATHER_ICONS)
     // create the middle canvas
@@ -728,11 +1057,14 @@ void setup(void) {
     // Load the weather icons
     for (uint8_t i = 0; i < ICON_COUNT; i++) {
         for (uint8_t j = 0; j < 2; j++) {
-            String icon_name = "/" + icon_names[i] + (j == 0 ? "d" : "n") + ".bmp";
-            rc = img_reader.loadBMP(icon_name.c_str(), icon[i][j]);
-            Serial.printf("Weather icon [%d/%d:%s] ", i, j, icon_name.c_str());
+            char icon_name[16];
+            snprintf(icon_name, sizeof(icon_name), "/%s%c.bmp", WEATHER_ICON_STEM[i], j == 0 ? 'd' : 'n');
+            rc = img_reader.loadBMP(icon_name, icon[i][j]);
+            Serial.printf("Weather icon [%d/%d:%s] ", i, j, icon_name);
             if (rc == IMAGE_SUCCESS) {
                 Serial.printf("LOADED! [%d x %d]\n", icon[i][j].width(), icon[i][j].height());
+                icon_mipmap_build(&icon_mipmap[i][j], icon[i][j].canvas.canvas16->getBuffer(), icon[i][j].width(), icon[i][j].height(),
+                                  ICON_MIPMAP_SCALES, sizeof(ICON_MIPMAP_SCALES));
             } else {
                 Serial.printf("FAILED : [%d]\n", (uint8_t)rc);
             }
@@ -788,7 +1120,28 @@ void setup(void) {
     bottom_canvas->cp437(true);
     bottom_canvas->setTextWrap(false);
 
-    matrix.drawRGBBitmap(0, 16, img.canvas.canvas16->getBuffer(), SCREEN_WIDTH, 32);
+    // cache the rendered lanes; each indicator is a segment that is re-rendered when its value changes
+    if (!lane_strip_begin(&top_lane, top_canvas) || !lane_strip_begin(&bottom_lane, bottom_canvas)) {
+        Serial.println("Could not allocate the lane strips");
+        err(250);
+    }
+    lane_strip_add_segment(&top_lane, indicator_info_top[IndTemperature].x, indicator_info_top[IndTemperature].w, display_temperature);
+    lane_strip_add_segment(&top_lane, indicator_info_top[IndWind].x, indicator_info_top[IndWind].w, display_wind);
+    lane_strip_add_segment(&top_lane, indicator_info_top[IndHumidity].x, indicator_info_top[IndHumidity].w, display_humidity);
+    lane_strip_add_segment(&bottom_lane, indicator_info_bottom[IndTime].x, indicator_info_bottom[IndTime].w, display_time);
+    lane_strip_add_segment(&bottom_lane, indicator_info_bottom[IndLocation].x, indicator_info_bottom[IndLocation].w, display_location);
+
+    // the cached forecast screen
+    forecast_panel = new PsramCanvas16(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // the colon of the clock
+    colon_canvas = new GFXcanvas16(5, 7);
+    colon_canvas->drawChar(0, 0, ':', matrix.color565(255, 255, 255), matrix.color565(255, 255, 255), 1, 1);
+    for (uint8_t i = 0; i < sizeof(colon_alpha); i++) {
+        colon_alpha[i] = colon_canvas->getBuffer()[i] ? 255 : 0;
+    }
+
+    blit_image(&matrix, 0, 16, img);
     matrix.show(); // Copy data to matrix buffers
 
     xTaskCreatePinnedToCore(animate_wait, "animate", 4096, NULL, 2, &task_animate, 0);
@@ -812,7 +1165,12 @@ void setup(void) {
     text_colour_565_temperature = matrix.color565(255, 237, 128); // light yellow
     text_colour_565_wind = matrix.color565(255, 192, 255);        // purplish
     text_colour_565_time = matrix.color565(160, 255, 160);        // greenish
+    text_colour_565_stale = matrix.color565(255, 176, 64);        // amber
+    text_colour_565_missing = matrix.color565(255, 64, 64);       // red
 
+#if !defined(SIMULATE_CURRENT_WEATHER_API) || !defined(SIMULATE_WEATHER_FORECAST_API)
+    http_cache_set_timeouts(client, FETCH_CONNECT_MS, FETCH_READ_MS, FETCH_BODY_MS);
+#endif
     xTaskCreatePinnedToCore(weather_task, "weather", 4096, NULL, 2, &task_weather, 0);
     // get_current_weather();
     // get_weather_icon();
@@ -823,21 +1181,47 @@ void setup(void) {
     }
 
     do_animation = 0;
+#if defined(OUTPUT_STAGE)
+    brightness_build(lookup, 256);
+    lookup_epoch++;
+    frame_pipeline_set_output(panel_output);
+#endif
+    frame_pipeline_begin(&matrix, RENDER_PIPELINE_DEPTH, RENDER_PUSH_CORE, RENDER_PUSH_PRIORITY);
+    screen = frame_pipeline_canvas();
+    transition_begin(&screen_transition, SCREEN_WIDTH, SCREEN_HEIGHT);
+    compositor_invalidate_all(); // the loading animation drew behind the compositor's back
     waiting_time_top = millis() + indicator_info_top[0].pause_ms;
     waiting_time_bottom = millis() + indicator_info_bottom[0].pause_ms;
 
 #endif // !defined(TEST_WEATHER_ICONS)
 
-    for (uint8_t i = 0; i < WEATHER_ICON_STEPS; i++) {
-        externalMemory[i] = (uint16_t *)heap_caps_malloc(WEATHER_ICON_SIZE * WEATHER_ICON_SIZE * 2, MALLOC_CAP_SPIRAM);
-        float t = i;
-        t /= WEATHER_ICON_STEPS * 8;
-
-        DrawWeatherIcon("01d", &weather_icon_canvas, t);
-        scale_down(weather_icon_canvas.getBuffer(), WEATHER_ICON_CANVAS_SIZE, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE, externalMemory[i], WEATHER_ICON_SCALE);
-    }
+    icon_sheet_begin(&icon_sheets, render_icon_frame, WEATHER_ICON_STEPS, ICON_SHEET_PSRAM_CAP);
 
     next_swap_time = millis() + showing_forecast ? FORECAST_WEATHER_DISPLAY_TIME_MS : CURRENT_WEATHER_DISPLAY_TIME_MS;
+
+    scheduler_begin(1000000L / MAX_FPS, MAX_CATCHUP_TICKS, micros());
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// METHOD: Screen transitions. While one runs, the incoming screen is composed onto the transition's canvas
+// and mixed with the outgoing one into the output.
+// ----------------------------------------------------------------------------------------------------------
+void start_screen_transition(TransitionKind kind) {
+    if (!transition_start(&screen_transition, kind, frame_pipeline_canvas()->getBuffer(), TRANSITION_TICKS)) return;
+    screen = screen_transition.to;
+    compositor_invalidate_all(); // new target
+}
+
+// Returns whether the output was drawn
+bool transition_step(uint8_t ticks, int32_t budget_us) {
+    GFXcanvas16 *output = frame_pipeline_canvas();
+    if (transition_advance(&screen_transition, ticks)) {
+        return transition_render(&screen_transition, output->getBuffer(), budget_us);
+    }
+    // done: the output takes over as the compositor's target, holding what it composed last
+    memcpy(output->getBuffer(), screen->getBuffer(), SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t));
+    screen = output;
+    return true;
 }
 
 // ==========================================================================================================
@@ -846,38 +1230,36 @@ void setup(void) {
 float t = 0;
 uint8_t weather_icon_index = 0;
 void loop() {
-    // Limit the animation frame rate to MAX_FPS.
-    // uint32_t t;
-    // while (((t = micros()) - prevTime) < (1000000L / MAX_FPS))
-    //     ;
-    // prevTime = t;
-
+#if defined(TEST_WEATHER_ICONS)
     // Clear the screen
     matrix.fillScreen(0x0);
 
-#if defined(TEST_WEATHER_ICONS)
-    // DrawWeatherIcon("01d", &weather_icon_canvas, t);
+    // uint16_t bmp[WEATHER_ICON_SIZE * WEATHER_ICON_SIZE];
+    // DrawWeatherIcon(IconClearSky, bmp, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE, t);
     // t += 0.01f;
     // if (t >= 1.0f) t -= 1.0f;
 
-    // uint16_t bmp[WEATHER_ICON_SIZE * WEATHER_ICON_SIZE];
-    // scale_down(weather_icon_canvas.getBuffer(), WEATHER_ICON_CANVAS_SIZE, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE, (uint16_t *)&bmp, WEATHER_ICON_SCALE);
-
     // // matrix.drawRGBBitmap(32 - previous_icon->width() / 2, 32 - previous_icon->height() / 2, previous_icon->canvas.canvas16->getBuffer(), previous_icon->width(), previous_icon->height());
     // middle_canvas->drawRGBBitmap(0, 0, bmp, WEATHER_ICON_SIZE, WEATHER_ICON_SIZE);
 
     // matrix.drawRGBBitmap(0, 16, middle_canvas->getBuffer(), middle_canvas->width(), middle_canvas->height());
 
-    matrix.drawRGBBitmap(0, 16, externalMemory[weather_icon_index], WEATHER_ICON_SIZE, WEATHER_ICON_SIZE);
+    draw_animated_icon(weather_icon_valid(CURRENT_ICON) ? CURRENT_ICON : IconClearSky, weather_icon_index, 0, 16, WEATHER_ICON_SIZE, &matrix);
     weather_icon_index++;
     weather_icon_index %= WEATHER_ICON_STEPS;
+    matrix.show(); // Copy data to matrix buffers
 #else
-    if (!showing_forecast) {
-        display_current_weather();
-    } else {
-        display_forecast_weather();
+    // Animation runs on fixed MAX_FPS ticks, however long rendering takes
+    uint32_t frame_start_us = micros();
+    uint8_t ticks = scheduler_ticks_due(frame_start_us);
+    if (ticks == 0) {
+        scheduler_sleep_until_next_tick();
+        return;
     }
 
+    // a new brightness table only ever takes effect between two frames
+    bool brightness_changed = swap_brightness_lookup();
+
     uint64_t now = millis();
     if (now > next_swap_time) {
         if (showing_forecast) {
@@ -885,16 +1267,74 @@ void loop() {
             waiting_time_top += FORECAST_WEATHER_DISPLAY_TIME_MS;
             waiting_time_bottom += FORECAST_WEATHER_DISPLAY_TIME_MS;
             next_swap_time = now + CURRENT_WEATHER_DISPLAY_TIME_MS;
+            start_screen_transition(TRANSITION_TO_CURRENT);
         } else {
             if ((indicator_left_x_top == indicator_info_top[0].x) && (indicator_left_x_bottom == indicator_info_bottom[0].x)) {
                 if (now > (waiting_time_top - indicator_info_top[0].pause_ms + 3000)) {
                     showing_forecast = true;
                     next_swap_time = now + FORECAST_WEATHER_DISPLAY_TIME_MS;
+                    start_screen_transition(TRANSITION_TO_FORECAST);
                 }
             }
         }
         // If the screen isn't scrolling
     }
-#endif             // defined(TEST_WEATHER_ICONS)
-    matrix.show(); // Copy data to matrix buffers
+
+    compositor_begin_frame();
+    if (!showing_forecast) {
+        for (uint8_t i = 0; i < ticks; i++) {
+            update_current_weather();
+        }
+        track_current_weather();
+    } else {
+        track_forecast_weather();
+    }
+
+    // Redraw only what changed; an unchanged frame is not pushed to the matrix at all
+    bool rendered = compositor_end_frame(screen);
+    if (screen == screen_transition.to) {
+        int32_t budget_us = scheduler_tick_us() - (micros() - frame_start_us);
+        rendered = transition_step(ticks, budget_us);
+    }
+#if defined(OUTPUT_STAGE)
+    // what the panel shows changes without anything being redrawn
+    rendered |= brightness_changed || OUTPUT_DITHER == OutputDitherTemporal;
+#else
+    (void)brightness_changed;
+#endif
+    if (rendered) {
+        frame_pipeline_submit(frame_start_us); // shown here, or queued for the push task
+    }
+    scheduler_frame_done(micros() - frame_start_us, rendered);
+
+#if defined(REPORT_FRAME_BUDGET)
+    static uint32_t next_report_ms = 0;
+    if (millis() > next_report_ms) {
+        next_report_ms = millis() + 10000;
+        const FrameSchedulerStats_t &fs = scheduler_stats();
+        Serial.printf("ticks=[%u] dropped=[%u] rendered=[%u] idle=[%u] overruns=[%u] budget=[%u.%u%% avg, %uus max]\n",
+                      fs.ticks, fs.ticks_dropped, fs.frames_rendered, fs.frames_idle, fs.overruns,
+                      fs.avg_used_permille / 10, fs.avg_used_permille % 10, fs.max_work_us);
+        Serial.printf("forecast panel hits=[%u] misses=[%u]\n", forecast_panel_stats.hits, forecast_panel_stats.misses);
+        Serial.printf("bri=[%u] lookup rebuilds=[%u] swaps=[%u] build=[%uus last, %uus max]\n",
+                      lookup_bri, lookup_stats.rebuilds, lookup_stats.swaps, lookup_stats.last_build_us, lookup_stats.max_build_us);
+        Serial.printf("icon sheets hits=[%u] renders=[%u] render=[%uus max, %uus total] sheets=[%u, %u evicted] bytes=[%u]\n",
+                      icon_sheets.stats.hits, icon_sheets.stats.frame_renders, icon_sheets.stats.max_render_us, icon_sheets.stats.total_render_us,
+                      icon_sheets.stats.sheet_allocs, icon_sheets.stats.evictions, (unsigned)icon_sheets.bytes);
+        const FramePipelineStats_t &ps = frame_pipeline_stats();
+        uint32_t fps_x10 = frame_pipeline_fps_x10();
+        Serial.printf("pipeline=[%s] frames=[%u] fps=[%u.%u] latency=[%uus avg, %uus max] push=[%uus max] stalls=[%u] "
+                      "shows=[%u skipped, %u row pairs]\n",
+                      frame_pipeline_pipelined() ? "pipelined" : "serial", ps.frames, fps_x10 / 10, fps_x10 % 10,
+                      ps.frames ? (uint32_t)(ps.total_latency_us / ps.frames) : 0, ps.max_latency_us, ps.max_push_us, ps.stalls,
+                      ps.shows_skipped, ps.row_pairs_shown);
+        frame_pipeline_reset_stats();
+        const TransitionStats_t &ts = screen_transition.stats;
+        Serial.printf("transitions=[%u] steps=[%u shown, %u skipped] step=[%uus last, %uus max]\n",
+                      ts.transitions, ts.steps_shown, ts.steps_skipped, ts.last_step_us, ts.max_step_us);
+    }
+#endif
+
+    scheduler_sleep_until_next_tick();
+#endif // defined(TEST_WEATHER_ICONS)
 }
@@ -0,0 +1,108 @@
+#include <Arduino.h>
+
+#include "output_stage.h"
+
+static const uint8_t BAYER[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+static const uint8_t TEMPORAL_SHIFT[4][2] = {{0, 0}, {2, 2}, {2, 0}, {0, 2}}; // x, y: every threshold once in 4 frames
+
+static uint16_t panel_level(uint8_t v, float gamma, uint16_t bri) {
+    float linear = powf(v / 255.0f, gamma);
+    return (uint16_t)(linear * bri * OUTPUT_STAGE_LEVELS + 0.5f); // * 256 / 256
+}
+
+void output_stage_set(OutputStage_t *stage, uint16_t bri, uint16_t gamma_x100, OutputDither dither) {
+    float gamma = gamma_x100 / 100.0f;
+    stage->bri = bri;
+    stage->gamma_x100 = gamma_x100;
+    stage->dither = dither;
+    for (uint16_t v = 0; v < 256; v++) {
+        uint16_t level = panel_level(v, gamma, bri);
+        stage->r8[v] = (uint32_t)level << 16;
+        stage->b8[v] = level;
+        stage->g8[v] = level;
+    }
+    for (uint8_t i = 0; i < 32; i++) {
+        uint8_t v = (i << 3) | (i >> 2);
+        stage->r5[i] = stage->r8[v];
+        stage->b5[i] = stage->b8[v];
+    }
+    for (uint8_t i = 0; i < 64; i++) {
+        stage->g6[i] = stage->g8[(i << 2) | (i >> 4)];
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Thresholds of row y, for x & 3 = 0..3, in 0..255
+// ----------------------------------------------------------------------------------------------------------
+static void row_thresholds(const OutputStage_t *stage, int16_t y, uint32_t frame, uint16_t *t) {
+    uint8_t sx = 0, sy = 0;
+    if (stage->dither == OutputDitherTemporal) {
+        sx = TEMPORAL_SHIFT[frame & 3][0];
+        sy = TEMPORAL_SHIFT[frame & 3][1];
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        t[i] = stage->dither == OutputDitherNone ? 128 : BAYER[(y + sy) & 3][(i + sx) & 3] * 16 + 8;
+    }
+}
+
+static inline uint16_t pack(uint32_t rb, uint16_t g) {
+    g >>= 8;
+    return ((rb >> 13) & 0xF800) | (g << 6) | ((g >> 4) << 5) | ((rb >> 8) & 0x1F);
+}
+
+void output_stage_565(const OutputStage_t *stage, const uint16_t *source, uint16_t *dest, int16_t w, int16_t h, uint32_t frame) {
+    const uint32_t *r5 = stage->r5, *b5 = stage->b5;
+    const uint16_t *g6 = stage->g6;
+    uint16_t t[4];
+    for (int16_t y = 0; y < h; y++) {
+        row_thresholds(stage, y, frame, t);
+        const uint32_t t0 = t[0] * 0x10001UL, t1 = t[1] * 0x10001UL, t2 = t[2] * 0x10001UL, t3 = t[3] * 0x10001UL;
+        int16_t x = 0;
+        for (; x + 4 <= w; x += 4) {
+            // read all four first: dest may be source
+            uint16_t c0 = source[x], c1 = source[x + 1], c2 = source[x + 2], c3 = source[x + 3];
+            uint16_t p0 = pack(r5[c0 >> 11] + b5[c0 & 0x1F] + t0, g6[(c0 >> 5) & 0x3F] + (uint16_t)t0);
+            uint16_t p1 = pack(r5[c1 >> 11] + b5[c1 & 0x1F] + t1, g6[(c1 >> 5) & 0x3F] + (uint16_t)t1);
+            uint16_t p2 = pack(r5[c2 >> 11] + b5[c2 & 0x1F] + t2, g6[(c2 >> 5) & 0x3F] + (uint16_t)t2);
+            uint16_t p3 = pack(r5[c3 >> 11] + b5[c3 & 0x1F] + t3, g6[(c3 >> 5) & 0x3F] + (uint16_t)t3);
+            dest[x] = p0;
+            dest[x + 1] = p1;
+            dest[x + 2] = p2;
+            dest[x + 3] = p3;
+        }
+        for (; x < w; x++) {
+            uint16_t c = source[x];
+            dest[x] = pack(r5[c >> 11] + b5[c & 0x1F] + t[x & 3] * 0x10001UL, g6[(c >> 5) & 0x3F] + t[x & 3]);
+        }
+        source += w;
+        dest += w;
+    }
+}
+
+void output_stage_888(const OutputStage_t *stage, const uint8_t *source, uint16_t *dest, int16_t w, int16_t h, uint32_t frame) {
+    uint16_t t[4];
+    for (int16_t y = 0; y < h; y++) {
+        row_thresholds(stage, y, frame, t);
+        for (int16_t x = 0; x < w; x++) {
+            uint32_t rb = stage->r8[source[0]] + stage->b8[source[2]] + t[x & 3] * 0x10001UL;
+            dest[x] = pack(rb, stage->g8[source[1]] + t[x & 3]);
+            source += 3;
+        }
+        dest += w;
+    }
+}
+
+void output_stage_565_reference(const OutputStage_t *stage, const uint16_t *source, uint16_t *dest, int16_t w, int16_t h,
+                                uint32_t frame) {
+    uint16_t t[4];
+    for (int16_t y = 0; y < h; y++) {
+        row_thresholds(stage, y, frame, t);
+        for (int16_t x = 0; x < w; x++) {
+            uint16_t c = *source++, threshold = t[x & 3];
+            uint16_t r = ((stage->r5[c >> 11] >> 16) + threshold) >> 8;
+            uint16_t g = (stage->g6[(c >> 5) & 0x3F] + threshold) >> 8;
+            uint16_t b = (stage->b5[c & 0x1F] + threshold) >> 8;
+            *dest++ = (r << 11) | (g << 6) | ((g >> 4) << 5) | b;
+        }
+    }
+}
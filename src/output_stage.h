@@ -0,0 +1,49 @@
+#ifndef _JVDW_OUTPUT_STAGE_H
+#define _JVDW_OUTPUT_STAGE_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Output stage: full-brightness frame to panel pixels
+//
+// Frames are composed at full brightness (RGB565, or 24-bit RGB from a GFXcanvas24b). On the way to the
+// panel each channel goes through a table that applies gamma and brightness and gives the panel level in
+// 8.8 fixed point. The level is then quantized with a threshold: a constant one (rounding), a 4x4 Bayer
+// matrix (ordered dithering), or the Bayer matrix shifted on every frame (temporal dithering, for frames
+// that are shown continuously). At low brightness the fraction that a plain >> 8 throws away is spread
+// over neighbouring pixels (and frames), so gradients keep their steps instead of collapsing onto a few.
+//
+// The panel is driven with 5 bits per channel (Protomatter's bit depth), which only uses the top five bits
+// of green, so every channel is quantized to 0..31; green is written back as 6 bits with its top bits
+// repeated.
+//
+// The kernel works on two channels at once: red and blue levels share a 32-bit word (red in the high half),
+// so one add applies the threshold to both. output_stage_565_reference does the same per channel, for
+// checking.
+// ----------------------------------------------------------------------------------------------------------
+#define OUTPUT_STAGE_LEVELS 31
+
+enum OutputDither : uint8_t {
+    OutputDitherNone,     // round to the nearest level
+    OutputDitherOrdered,  // 4x4 Bayer matrix
+    OutputDitherTemporal, // 4x4 Bayer matrix, moved on every frame
+};
+
+struct OutputStage_t
+{
+    uint16_t bri, gamma_x100;
+    OutputDither dither;
+    uint32_t r5[32], b5[32], r8[256], b8[256]; // levels in 8.8, red in the high half of the word
+    uint16_t g6[64], g8[256];
+};
+
+// Build the tables for a brightness of bri/256 and a gamma of gamma_x100/100 (100: linear)
+void output_stage_set(OutputStage_t *stage, uint16_t bri, uint16_t gamma_x100, OutputDither dither);
+
+// Convert w x h pixels; frame picks the temporal pattern. dest may be source for the RGB565 version.
+void output_stage_565(const OutputStage_t *stage, const uint16_t *source, uint16_t *dest, int16_t w, int16_t h, uint32_t frame);
+void output_stage_888(const OutputStage_t *stage, const uint8_t *source, uint16_t *dest, int16_t w, int16_t h, uint32_t frame);
+void output_stage_565_reference(const OutputStage_t *stage, const uint16_t *source, uint16_t *dest, int16_t w, int16_t h,
+                                uint32_t frame);
+
+#endif // _JVDW_OUTPUT_STAGE_H
@@ -0,0 +1,63 @@
+#include <Arduino.h>
+
+#include "protomatter_rows.h"
+
+// The matrix's private core: defined by the explicit instantiation below, which may name the member
+Protomatter_core *protomatter_core(Adafruit_Protomatter *matrix);
+
+template <Protomatter_core Adafruit_Protomatter::*Core>
+struct ProtomatterCoreAccess
+{
+    friend Protomatter_core *protomatter_core(Adafruit_Protomatter *matrix) { return &(matrix->*Core); }
+};
+template struct ProtomatterCoreAccess<&Adafruit_Protomatter::core>;
+
+static uint16_t *pair_rows = NULL; // the two rows of a row pair, upper then lower
+static int16_t pair_width = 0;
+
+bool protomatter_rows_supported(Adafruit_Protomatter *matrix) {
+    const Protomatter_core *core = protomatter_core(matrix);
+    return core->parallel == 1 && abs(core->tile) == 1 && core->numRowPairs > 0 && core->numRowPairs <= 64 &&
+           core->bufferSize % core->numRowPairs == 0;
+}
+
+uint8_t protomatter_row_pairs(Adafruit_Protomatter *matrix) {
+    return protomatter_core(matrix)->numRowPairs;
+}
+
+bool protomatter_double_buffered(Adafruit_Protomatter *matrix) {
+    return protomatter_core(matrix)->doubleBuffer;
+}
+
+void protomatter_show_rows(Adafruit_Protomatter *matrix, uint64_t row_pairs) {
+    const int16_t w = matrix->width();
+    if (pair_width != w) {
+        heap_caps_free(pair_rows);
+        pair_rows = (uint16_t *)heap_caps_malloc(2 * w * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        pair_width = pair_rows ? w : 0;
+    }
+    if (pair_rows == NULL || !protomatter_rows_supported(matrix)) {
+        matrix->show();
+        return;
+    }
+
+    Protomatter_core *core = protomatter_core(matrix);
+    const uint8_t pairs = core->numRowPairs;
+    const uint32_t pair_bytes = core->bufferSize / pairs; // all the planes of one row pair
+    uint8_t *drawn = (uint8_t *)core->screenData;
+    if (core->doubleBuffer) drawn += core->bufferSize * (1 - core->activeBuffer);
+
+    Protomatter_core pair = *core;
+    pair.numRowPairs = 1;
+    pair.bufferSize = pair_bytes;
+    pair.doubleBuffer = false; // screenData is set to the buffer being drawn into
+    const uint16_t *frame = matrix->getBuffer();
+    for (uint8_t p = 0; p < pairs; p++) {
+        if (!((row_pairs >> p) & 1)) continue;
+        memcpy(pair_rows, frame + p * w, w * sizeof(uint16_t));
+        memcpy(pair_rows + w, frame + (p + pairs) * w, w * sizeof(uint16_t));
+        pair.screenData = drawn + p * pair_bytes;
+        _PM_convert_565(&pair, pair_rows, w);
+    }
+    _PM_swapbuffer_maybe(core);
+}
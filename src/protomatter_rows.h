@@ -0,0 +1,35 @@
+#ifndef _JVDW_PROTOMATTER_ROWS_H
+#define _JVDW_PROTOMATTER_ROWS_H
+
+#include <Adafruit_Protomatter.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Showing only some rows of a Protomatter matrix
+//
+// Adafruit_Protomatter::show() converts the whole framebuffer into bit planes, through the library's C core
+// (_PM_convert_565, then _PM_swapbuffer_maybe). This goes through the same core one row pair at a time: row
+// pair p (rows p and p + height / 2) is copied out on its own and converted by a copy of the core that has
+// one row pair and points at that row pair's part of the buffer being drawn into. The rest of that buffer is
+// left as it was.
+//
+// With double buffering that buffer was last drawn two shows ago, so the caller has to ask for every row pair
+// that changed since then, not just since the last show.
+//
+// The core is a private member of Adafruit_Protomatter; it is reached without patching the library, by way
+// of an explicit template instantiation (which may name private members). This depends on the fields of
+// Protomatter_core in the library's core.h: screenData, bufferSize, numRowPairs, parallel, tile, doubleBuffer
+// and activeBuffer.
+// ----------------------------------------------------------------------------------------------------------
+
+// Whether row pairs can be shown on their own: one chain of panels, not tiled, and no more than 64 row pairs
+bool protomatter_rows_supported(Adafruit_Protomatter *matrix);
+
+uint8_t protomatter_row_pairs(Adafruit_Protomatter *matrix);
+
+bool protomatter_double_buffered(Adafruit_Protomatter *matrix);
+
+// Convert the row pairs set in row_pairs (bit p: row pair p) into the buffer not being displayed, and swap
+// it in. Shows the whole frame instead if row pairs can't be shown on their own.
+void protomatter_show_rows(Adafruit_Protomatter *matrix, uint64_t row_pairs);
+
+#endif // _JVDW_PROTOMATTER_ROWS_H
@@ -0,0 +1,16 @@
+#include <Arduino.h>
+
+#include "psram_canvas.h"
+
+PsramCanvas16::PsramCanvas16(uint16_t w, uint16_t h) : GFXcanvas16(w, h, false) {
+    size_t bytes = (size_t)w * h * sizeof(uint16_t);
+    buffer = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    in_psram = buffer != NULL;
+    if (buffer == NULL) buffer = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_DEFAULT);
+    if (buffer) memset(buffer, 0, bytes);
+}
+
+PsramCanvas16::~PsramCanvas16(void) {
+    if (buffer) heap_caps_free(buffer);
+    buffer = NULL; // GFXcanvas16 didn't allocate it, so it mustn't free it
+}
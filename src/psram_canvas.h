@@ -0,0 +1,20 @@
+#ifndef _JVDW_PSRAM_CANVAS_H
+#define _JVDW_PSRAM_CANVAS_H
+
+#include <Adafruit_GFX.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// 16-bit canvas whose buffer lives in PSRAM (or on the heap if there is no PSRAM left); for surfaces that
+// are rendered once and blitted many times, where internal RAM is better spent elsewhere
+// ----------------------------------------------------------------------------------------------------------
+class PsramCanvas16 : public GFXcanvas16 {
+public:
+    PsramCanvas16(uint16_t w, uint16_t h);
+    ~PsramCanvas16(void);
+    bool inPsram(void) const { return in_psram; }
+
+private:
+    bool in_psram;
+};
+
+#endif // _JVDW_PSRAM_CANVAS_H
@@ -0,0 +1,108 @@
+#include <Arduino.h>
+
+#include <JvdW_RGB565Kernels.h>
+
+#include "screen_transition.h"
+
+bool transition_begin(ScreenTransition_t *t, int16_t w, int16_t h) {
+    memset(t, 0, sizeof(*t));
+    t->w = w;
+    t->h = h;
+    t->from = (uint16_t *)malloc(w * h * sizeof(uint16_t));
+    t->to = new GFXcanvas16(w, h);
+    if (t->from == NULL || t->to->getBuffer() == NULL) {
+        free(t->from);
+        delete t->to;
+        t->from = NULL;
+        t->to = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool transition_start(ScreenTransition_t *t, TransitionKind kind, const uint16_t *from, uint16_t ticks) {
+    if (kind == TransitionCut || t->from == NULL || ticks == 0) return false;
+    memcpy(t->from, from, t->w * t->h * sizeof(uint16_t));
+    t->kind = kind;
+    t->ticks = ticks;
+    t->elapsed = 0;
+    t->stats.transitions++;
+    return true;
+}
+
+bool transition_running(const ScreenTransition_t *t) {
+    return t->elapsed < t->ticks;
+}
+
+bool transition_advance(ScreenTransition_t *t, uint8_t ticks) {
+    if (!transition_running(t)) return false;
+    t->elapsed = min((uint16_t)(t->elapsed + ticks), t->ticks);
+    return transition_running(t);
+}
+
+// ----------------------------------------------------------------------------------------------------------
+// Mixing: position 0..256 is how far along the transition is. Slides and wipes ease in and out
+// (smoothstep), a crossfade changes evenly.
+// ----------------------------------------------------------------------------------------------------------
+static uint16_t eased(uint16_t p) {
+    return ((uint32_t)p * p * (3 * 256 - 2 * p)) >> 16;
+}
+
+static void slide(const ScreenTransition_t *t, uint16_t *dest, uint16_t p) {
+    int16_t shift = ((int32_t)t->w * p) >> 8, keep = t->w - shift;
+    const uint16_t *from = t->from, *to = t->to->getBuffer();
+    for (int16_t y = 0; y < t->h; y++) {
+        memcpy(dest, from + shift, keep * sizeof(uint16_t));
+        memcpy(dest + keep, to, shift * sizeof(uint16_t));
+        from += t->w;
+        to += t->w;
+        dest += t->w;
+    }
+}
+
+static void wipe(const ScreenTransition_t *t, uint16_t *dest, uint16_t p) {
+    int32_t edge = (int32_t)t->w * p; // 8.8: columns left of it are the incoming screen
+    int16_t x = edge >> 8, rest = t->w - x - 1;
+    uint16_t weight = edge & 0xFF;
+    const uint16_t *from = t->from, *to = t->to->getBuffer();
+    for (int16_t y = 0; y < t->h; y++) {
+        memcpy(dest, to, x * sizeof(uint16_t));
+        if (rest >= 0) {
+            RGB565.blend(to + x, from + x, dest + x, 1, weight);
+            memcpy(dest + x + 1, from + x + 1, rest * sizeof(uint16_t));
+        }
+        from += t->w;
+        to += t->w;
+        dest += t->w;
+    }
+}
+
+bool transition_render(ScreenTransition_t *t, uint16_t *dest, int32_t budget_us) {
+    if ((int32_t)t->step_us > budget_us) {
+        t->step_us -= t->step_us >> 3; // so that one slow step doesn't rule out the rest
+        t->stats.steps_skipped++;
+        return false;
+    }
+
+    uint32_t start_us = micros();
+    uint16_t p = ((uint32_t)t->elapsed << 8) / t->ticks;
+    switch (t->kind) {
+    case TransitionSlide:
+        slide(t, dest, eased(p));
+        break;
+    case TransitionWipe:
+        wipe(t, dest, eased(p));
+        break;
+    default:
+        RGB565.blend(t->to->getBuffer(), t->from, dest, t->w * t->h, p);
+        break;
+    }
+
+    // the estimate follows a dearer step at once and a cheaper one slowly
+    uint32_t step_us = micros() - start_us;
+    t->step_us = step_us > t->step_us ? step_us : (t->step_us * 7 + step_us) >> 3;
+    t->stats.steps_shown++;
+    t->stats.last_step_us = step_us;
+    if (step_us > t->stats.max_step_us) t->stats.max_step_us = step_us;
+    return true;
+}
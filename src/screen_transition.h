@@ -0,0 +1,60 @@
+#ifndef _JVDW_SCREEN_TRANSITION_H
+#define _JVDW_SCREEN_TRANSITION_H
+
+#include <Adafruit_GFX.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Transitions between two screens
+//
+// When a transition starts, the outgoing screen is copied into a surface of its own and stays as it was.
+// The incoming screen is composed, live, into a second canvas. Each frame the two are mixed into the output
+// at a fixed-point position 0..256 that follows the scheduler ticks, so a transition lasts as long however
+// many frames are shown along the way.
+//
+// Mixing a step costs a roughly fixed amount, which is tracked. A step that wouldn't fit in what is left of
+// the frame budget is skipped: the output keeps the previous step for that frame and the next step jumps
+// ahead, so slow frames give a transition fewer intermediate steps and the rest of the screen keeps to
+// its ticks.
+// ----------------------------------------------------------------------------------------------------------
+enum TransitionKind : uint8_t {
+    TransitionCut,       // straight to the incoming screen
+    TransitionCrossfade, // blend the whole screen
+    TransitionSlide,     // the incoming screen pushes the outgoing one out to the left
+    TransitionWipe,      // the incoming screen is uncovered from the left, with a soft edge
+};
+
+struct TransitionStats_t
+{
+    uint32_t transitions;
+    uint32_t steps_shown;   // intermediate frames mixed and shown
+    uint32_t steps_skipped; // intermediate frames left out to stay within budget
+    uint32_t last_step_us, max_step_us;
+};
+
+struct ScreenTransition_t
+{
+    GFXcanvas16 *to; // the incoming screen is composed here while a transition runs
+    uint16_t *from;  // the outgoing screen
+    int16_t w, h;
+    TransitionKind kind;
+    uint16_t ticks, elapsed; // length and progress, in scheduler ticks (running while elapsed < ticks)
+    uint32_t step_us;        // estimated cost of mixing one step
+    TransitionStats_t stats;
+};
+
+// Allocate the surfaces for a w x h screen; returns false if they can't be had (every transition is a cut)
+bool transition_begin(ScreenTransition_t *t, int16_t w, int16_t h);
+
+// Start a transition from the screen in from (w x h) to whatever is composed on t->to, over ticks ticks.
+// Returns false, without starting, for a cut or when there are no surfaces.
+bool transition_start(ScreenTransition_t *t, TransitionKind kind, const uint16_t *from, uint16_t ticks);
+
+bool transition_running(const ScreenTransition_t *t);
+
+// Move on by ticks; returns false once the transition has reached its end (t->to then is the whole screen)
+bool transition_advance(ScreenTransition_t *t, uint8_t ticks);
+
+// Mix the current step into dest, unless it wouldn't be done within budget_us; returns whether it was
+bool transition_render(ScreenTransition_t *t, uint16_t *dest, int32_t budget_us);
+
+#endif // _JVDW_SCREEN_TRANSITION_H
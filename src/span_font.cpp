@@ -0,0 +1,78 @@
+#include <Arduino.h>
+
+#include "span_font.h"
+
+#define GFX_FONT_WIDTH 6 // classic font: 5 columns and a column of spacing
+#define GFX_FONT_HEIGHT 8
+
+bool span_font_build(SpanFont_t *font, const char *chars) {
+    GFXcanvas1 cell(GFX_FONT_WIDTH, GFX_FONT_HEIGHT);
+    if (cell.getBuffer() == NULL) return false;
+    cell.cp437(true); // as the canvases the text is printed on: codes from 0xB0 on aren't shifted by one
+
+    font->height = GFX_FONT_HEIGHT;
+    font->advance = GFX_FONT_WIDTH;
+    font->glyph_count = 0;
+    font->span_count = 0;
+    memset(font->glyph_index, SPAN_FONT_NO_GLYPH, sizeof(font->glyph_index));
+
+    for (const uint8_t *c = (const uint8_t *)chars; *c; c++) {
+        if (font->glyph_count == SPAN_FONT_MAX_GLYPHS) return false;
+        SpanGlyph_t *glyph = &font->glyph[font->glyph_count];
+        glyph->first = font->span_count;
+        glyph->count = 0;
+
+        cell.fillScreen(0);
+        cell.drawChar(0, 0, *c, 1, 1, 1, 1);
+        for (uint8_t y = 0; y < GFX_FONT_HEIGHT; y++) {
+            for (uint8_t x = 0; x < GFX_FONT_WIDTH;) {
+                if (!cell.getPixel(x, y)) {
+                    x++;
+                    continue;
+                }
+                uint8_t start = x;
+                while (x < GFX_FONT_WIDTH && cell.getPixel(x, y)) x++;
+                if (font->span_count == SPAN_FONT_MAX_SPANS) return false;
+                font->span[font->span_count++] = (y << 8) | (start << 4) | (x - start);
+                glyph->count++;
+            }
+        }
+        font->glyph_index[*c] = font->glyph_count++;
+    }
+    return true;
+}
+
+int16_t span_text_width(const SpanFont_t *font, const char *text) {
+    return strlen(text) * font->advance;
+}
+
+int16_t span_text_draw(const SpanFont_t *font, uint16_t *pixels, int16_t w, int16_t h, int16_t x, int16_t y,
+                       const char *text, uint16_t colour) {
+    const bool rows_inside = y >= 0 && y + font->height <= h;
+    if (y >= h || y + font->height <= 0) return x + span_text_width(font, text);
+
+    for (const uint8_t *c = (const uint8_t *)text; *c; c++, x += font->advance) {
+        uint8_t index = font->glyph_index[*c];
+        if (index == SPAN_FONT_NO_GLYPH || x >= w || x + font->advance <= 0) continue;
+        const SpanGlyph_t *glyph = &font->glyph[index];
+        const uint16_t *span = &font->span[glyph->first], *end = span + glyph->count;
+
+        if (rows_inside && x >= 0 && x + font->advance <= w) {
+            // the whole cell is on the buffer: no clipping
+            uint16_t *cell = pixels + y * w + x;
+            for (; span < end; span++) {
+                uint16_t *p = cell + (*span >> 8) * w + ((*span >> 4) & 0xF);
+                for (uint8_t n = *span & 0xF; n; n--) *p++ = colour;
+            }
+            continue;
+        }
+        for (; span < end; span++) {
+            int16_t row = y + (*span >> 8), x0 = x + ((*span >> 4) & 0xF), x1 = x0 + (*span & 0xF);
+            if (row < 0 || row >= h) continue;
+            if (x0 < 0) x0 = 0;
+            if (x1 > w) x1 = w;
+            for (uint16_t *p = pixels + row * w + x0; x0 < x1; x0++) *p++ = colour;
+        }
+    }
+    return x;
+}
@@ -0,0 +1,58 @@
+#ifndef _JVDW_SPAN_FONT_H
+#define _JVDW_SPAN_FONT_H
+
+#include <Adafruit_GFX.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Run-length text
+//
+// Adafruit_GFX draws text one pixel at a time: every set bit of a glyph is a clipped, rotated drawPixel call
+// (or a fillRect when scaled), so a short line of text costs a few hundred calls. A span font keeps each glyph
+// as its runs of set pixels, row by row, and draws a line of text by filling those runs straight into the
+// RGB565 buffer; only glyphs that cross an edge of the buffer are clipped, run by run.
+//
+// The font is made at startup from Adafruit_GFX's own 5x7 font, drawn once per character into a 1-bit
+// canvas, so the text comes out pixel for pixel as the GFX print path draws it (transparent background,
+// size 1, no wrapping), including its mapping of the code page 437 characters above 0x7F.
+// ----------------------------------------------------------------------------------------------------------
+#define SPAN_FONT_MAX_GLYPHS 100
+#define SPAN_FONT_MAX_SPANS 1280
+#define SPAN_FONT_NO_GLYPH 0xFF
+
+// the characters made by default: printable ASCII and the degree sign
+#define SPAN_FONT_DEFAULT_CHARS                                                                                      \
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~\xF8"
+
+struct SpanGlyph_t
+{
+    uint16_t first; // index of the glyph's first span
+    uint8_t count;  // spans, top row first
+};
+
+struct SpanFont_t
+{
+    uint8_t height, advance;
+    uint8_t glyph_index[256]; // per character code; SPAN_FONT_NO_GLYPH: only advances
+    uint8_t glyph_count;
+    uint16_t span_count;
+    SpanGlyph_t glyph[SPAN_FONT_MAX_GLYPHS];
+    uint16_t span[SPAN_FONT_MAX_SPANS]; // row << 8 | x << 4 | length, relative to the glyph's top left
+};
+
+// Make the glyphs of chars from the GFX built-in font; returns false if they don't all fit
+bool span_font_build(SpanFont_t *font, const char *chars = SPAN_FONT_DEFAULT_CHARS);
+
+// Width that drawing text takes up, i.e. how far it moves the cursor (the last column is spacing)
+int16_t span_text_width(const SpanFont_t *font, const char *text);
+
+// Draw text with its top left at x, y into a w x h RGB565 buffer; returns the x after the text
+int16_t span_text_draw(const SpanFont_t *font, uint16_t *pixels, int16_t w, int16_t h, int16_t x, int16_t y,
+                       const char *text, uint16_t colour);
+
+// Same, into an unrotated canvas (e.g. the matrix)
+static inline int16_t span_text_draw(const SpanFont_t *font, GFXcanvas16 *canvas, int16_t x, int16_t y,
+                                     const char *text, uint16_t colour) {
+    return span_text_draw(font, canvas->getBuffer(), canvas->width(), canvas->height(), x, y, text, colour);
+}
+
+#endif // _JVDW_SPAN_FONT_H
@@ -0,0 +1,49 @@
+#include <Arduino.h>
+
+#include <JvdW_RGB565Kernels.h>
+
+#include "subpixel_sprite.h"
+
+void subpixel_sprite_set(SubpixelSprite_t *sprite, const uint16_t *source, uint16_t w, uint16_t h, uint8_t phases) {
+    if (sprite->source == source && sprite->w == w && sprite->h == h && sprite->phases == phases) return;
+    if (phases > SUBPIXEL_MAX_PHASES) phases = SUBPIXEL_MAX_PHASES;
+
+    size_t needed = (size_t)phases * w * h;
+    if (needed > sprite->capacity) {
+        if (sprite->pixels) heap_caps_free(sprite->pixels);
+        sprite->pixels = (uint16_t *)heap_caps_malloc(needed * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+        if (sprite->pixels == NULL) sprite->pixels = (uint16_t *)heap_caps_malloc(needed * sizeof(uint16_t), MALLOC_CAP_DEFAULT);
+        sprite->capacity = sprite->pixels ? needed : 0;
+    }
+    sprite->source = source;
+    sprite->w = w;
+    sprite->h = h;
+    sprite->phases = phases;
+    memset(sprite->ready, 0, sizeof(sprite->ready));
+}
+
+void subpixel_sprite_render(const SubpixelSprite_t *sprite, uint8_t phase, const BrightnessTable_t *table, uint16_t *dest) {
+    uint16_t W = sprite->w, H = sprite->h;
+    uint16_t weight = ((uint32_t)phase << 8) / sprite->phases;
+    for (uint16_t y = 0; y < H - 1; y++) {
+        dest[y * W] = 0;
+        RGB565.blend(sprite->source + y * W, sprite->source + y * W + 1, dest + y * W + 1, W - 1, weight);
+    }
+    memset(dest + (H - 1) * W, 0, W * sizeof(uint16_t));
+    brightness_scale_buffer(table, dest, dest, W * H);
+}
+
+const uint16_t *subpixel_sprite_phase(SubpixelSprite_t *sprite, uint8_t phase, const BrightnessTable_t *table, uint32_t epoch) {
+    if (sprite->pixels == NULL || phase >= sprite->phases) return NULL;
+    if (sprite->epoch != epoch) {
+        memset(sprite->ready, 0, sizeof(sprite->ready));
+        sprite->epoch = epoch;
+    }
+    uint16_t *pixels = sprite->pixels + (size_t)phase * sprite->w * sprite->h;
+    if (!sprite->ready[phase]) {
+        subpixel_sprite_render(sprite, phase, table, pixels);
+        sprite->ready[phase] = true;
+        sprite->phase_renders++;
+    }
+    return pixels;
+}
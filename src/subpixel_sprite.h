@@ -0,0 +1,40 @@
+#ifndef _JVDW_SUBPIXEL_SPRITE_H
+#define _JVDW_SUBPIXEL_SPRITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "brightness.h"
+
+// ----------------------------------------------------------------------------------------------------------
+// Sprite pre-rendered at a number of horizontal sub-pixel phases
+//
+// Phase p of an image w pixels wide blends every pixel with its right-hand neighbour, giving the left one a
+// weight of p/phases, and is shifted one pixel right (column 0 and the bottom row are left black). The
+// phases are rendered on first use, at the current brightness, and kept until the image or the brightness
+// table changes, so drawing the sprite at any sub-pixel position is a plain blit.
+// ----------------------------------------------------------------------------------------------------------
+#define SUBPIXEL_MAX_PHASES 128
+
+struct SubpixelSprite_t
+{
+    const uint16_t *source;
+    uint16_t w, h;
+    uint8_t phases;
+    uint32_t epoch;                     // brightness table epoch the phases were rendered with
+    uint16_t *pixels;                   // phases * w * h, NULL if it could not be allocated
+    size_t capacity;                    // pixels allocated
+    uint8_t ready[SUBPIXEL_MAX_PHASES]; // phase rendered
+    uint32_t phase_renders;
+};
+
+// Use source (w x h) with the given number of phases (a power of 2, at most SUBPIXEL_MAX_PHASES); does
+// nothing if that's what the sprite already holds
+void subpixel_sprite_set(SubpixelSprite_t *sprite, const uint16_t *source, uint16_t w, uint16_t h, uint8_t phases);
+
+// The pixels of a phase at the brightness of table, rendered now if needed; NULL if there is no memory to
+// keep them, in which case subpixel_sprite_render can render into a buffer of the caller's
+const uint16_t *subpixel_sprite_phase(SubpixelSprite_t *sprite, uint8_t phase, const BrightnessTable_t *table, uint32_t epoch);
+void subpixel_sprite_render(const SubpixelSprite_t *sprite, uint8_t phase, const BrightnessTable_t *table, uint16_t *dest);
+
+#endif // _JVDW_SUBPIXEL_SPRITE_H
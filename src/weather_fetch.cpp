@@ -0,0 +1,87 @@
+#include "weather_fetch.h"
+
+void weather_fetch_begin(WeatherFetch_t *fetch, uint32_t interval_ms) {
+    *fetch = {};
+    fetch->interval_ms = interval_ms;
+    fetch->backoff_ms = FETCH_BACKOFF_MIN_MS;
+    fetch->state = FetchRunning;
+    fetch->refresh_ms = millis();
+    fetch->refreshes = 1;
+}
+
+bool weather_fetch_add_step(WeatherFetch_t *fetch, WeatherFetchStep_t step) {
+    if (fetch->step_count >= FETCH_STEPS_MAX) return false;
+    fetch->steps[fetch->step_count++] = step;
+    return true;
+}
+
+// Wait before trying the failed step again, or going on with the next
+static void back_off(WeatherFetch_t *fetch, uint32_t retry_after_ms) {
+    uint32_t wait = fetch->backoff_ms / 2 + random(fetch->backoff_ms / 2 + 1);
+    if (wait < retry_after_ms) wait = retry_after_ms;
+    fetch->wait_until_ms = millis() + wait;
+    fetch->backoff_ms = min(fetch->backoff_ms * 2, (uint32_t)FETCH_BACKOFF_MAX_MS);
+    fetch->state = FetchBackoff;
+}
+
+bool weather_fetch_poll(WeatherFetch_t *fetch, uint32_t now_ms) {
+    if (fetch->step_count == 0) return false;
+    switch (fetch->state) {
+    case FetchIdle:
+        if (now_ms - fetch->refresh_ms < fetch->interval_ms) return false;
+        fetch->refresh_ms = now_ms;
+        fetch->step = 0;
+        fetch->updated = false;
+        fetch->refreshes++;
+        fetch->state = FetchRunning;
+        break;
+    case FetchBackoff:
+        if ((int32_t)(now_ms - fetch->wait_until_ms) < 0) return false;
+        if (fetch->attempts) fetch->retries++;
+        fetch->state = FetchRunning;
+        break;
+    case FetchRunning:
+        break;
+    }
+
+    uint32_t retry_after_ms = 0, start_us = micros();
+    WeatherFetchResult result = fetch->steps[fetch->step](&retry_after_ms);
+    fetch->last_step_us = micros() - start_us;
+    if (fetch->last_step_us > fetch->max_step_us) fetch->max_step_us = fetch->last_step_us;
+    fetch->step_runs++;
+
+    if (result == FetchFailed) {
+        fetch->step_failures++;
+        if (fetch->failures_in_row < 0xFF) fetch->failures_in_row++;
+        back_off(fetch, retry_after_ms);
+        if (++fetch->attempts < FETCH_STEP_ATTEMPTS) return false;
+        fetch->steps_skipped++; // the next refresh tries it again
+    } else {
+        fetch->failures_in_row = 0;
+        fetch->backoff_ms = FETCH_BACKOFF_MIN_MS;
+        fetch->last_ok_ms[fetch->step] = millis();
+        fetch->ok_mask |= 1 << fetch->step;
+        if (result == FetchUpdated) fetch->updated = true;
+    }
+    fetch->attempts = 0;
+    if (++fetch->step < fetch->step_count) return false;
+
+    fetch->step = 0;
+    fetch->state = FetchIdle;
+    return fetch->updated;
+}
+
+uint32_t weather_fetch_age_ms(const WeatherFetch_t *fetch, uint32_t now_ms) {
+    if (fetch->step_count == 0 || fetch->ok_mask != (1 << fetch->step_count) - 1) return UINT32_MAX;
+    uint32_t age = 0;
+    for (uint8_t i = 0; i < fetch->step_count; i++) {
+        age = max(age, now_ms - fetch->last_ok_ms[i]);
+    }
+    return age;
+}
+
+WeatherStaleness weather_fetch_staleness(const WeatherFetch_t *fetch, uint32_t now_ms) {
+    uint32_t age = weather_fetch_age_ms(fetch, now_ms);
+    if (age == UINT32_MAX) return WeatherMissing;
+    return age > 2 * fetch->interval_ms ? WeatherStale : WeatherFresh;
+}
@@ -0,0 +1,86 @@
+#ifndef _JVDW_WEATHER_FETCH_H
+#define _JVDW_WEATHER_FETCH_H
+
+#include <Arduino.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Weather fetch state machine
+//
+// A refresh is a fixed list of steps (the current weather, then the forecast), each one request that fetches,
+// checks and only then stores what it got; a step reports whether it updated the weather, found it unchanged,
+// or failed (no connection, a deadline passed, a status other than 200 or 304, or content that didn't parse).
+//
+// weather_fetch_poll() is called over and over from weather_task and does at most one step per call, so a
+// refresh never holds the task for longer than one request's deadlines. When a step fails the refresh waits and
+// then tries that same step again, up to FETCH_STEP_ATTEMPTS times; after that it moves on to the next step
+// and leaves the failed one to the next refresh, so one endpoint that is down doesn't keep the others from
+// being fetched, and every refresh comes to an end. The wait starts at FETCH_BACKOFF_MIN_MS and doubles with
+// every failure in a row, up to FETCH_BACKOFF_MAX_MS, and half of it is random, so clients that failed
+// together don't all come back at the same moment. A server's Retry-After lengthens it. The next refresh is due
+// an interval after the last one started, however long that took.
+//
+// For the display, every step keeps when it last succeeded; the weather is stale once the oldest of those is
+// more than two intervals old (one refresh has been missed entirely), and missing until each has succeeded.
+// ----------------------------------------------------------------------------------------------------------
+#define FETCH_STEPS_MAX 4
+#define FETCH_STEP_ATTEMPTS 3
+#define FETCH_BACKOFF_MIN_MS 5000
+#define FETCH_BACKOFF_MAX_MS (5 * 60 * 1000)
+
+enum WeatherFetchResult : uint8_t {
+    FetchUpdated = 0,
+    FetchUnchanged,
+    FetchFailed
+};
+
+enum WeatherFetchState : uint8_t {
+    FetchIdle = 0, // waiting for the next refresh
+    FetchRunning,  // a refresh is under way; the next poll does its next step
+    FetchBackoff   // a step failed; waiting to try it again, or to go on with the next one
+};
+
+enum WeatherStaleness : uint8_t {
+    WeatherFresh = 0,
+    WeatherStale,  // shown, but a refresh has been missed
+    WeatherMissing // some part has never been fetched
+};
+
+// A step of a refresh; may set *retry_after_ms when it fails and the server said how long to wait
+typedef WeatherFetchResult (*WeatherFetchStep_t)(uint32_t *retry_after_ms);
+
+struct WeatherFetch_t
+{
+    WeatherFetchStep_t steps[FETCH_STEPS_MAX];
+    uint32_t last_ok_ms[FETCH_STEPS_MAX]; // millis() of each step's last success
+    uint8_t step_count, step;              // the step to do next
+    uint8_t attempts;                      // of that step in this refresh that have failed
+    WeatherFetchState state;
+    uint32_t interval_ms;
+    uint32_t refresh_ms;   // millis() the current (or last) refresh started
+    uint32_t wait_until_ms; // end of the backoff
+    uint32_t backoff_ms;   // before jitter, for the next failure
+    uint8_t ok_mask;       // steps that have succeeded at least once
+    bool updated;          // some step of the current refresh updated the weather
+
+    // stats
+    uint32_t refreshes, step_runs, step_failures, retries;
+    uint32_t steps_skipped; // given up on, FETCH_STEP_ATTEMPTS having failed
+    uint8_t failures_in_row;
+    uint32_t last_step_us, max_step_us;
+};
+
+// Start with a refresh due at once
+void weather_fetch_begin(WeatherFetch_t *fetch, uint32_t interval_ms);
+
+// Add a step; false if there is no room
+bool weather_fetch_add_step(WeatherFetch_t *fetch, WeatherFetchStep_t step);
+
+// Do the next step if one is due; returns true when that finished a refresh that updated the weather
+bool weather_fetch_poll(WeatherFetch_t *fetch, uint32_t now_ms);
+
+// How old the oldest part of the weather is, or UINT32_MAX if some part has never been fetched
+uint32_t weather_fetch_age_ms(const WeatherFetch_t *fetch, uint32_t now_ms);
+
+WeatherStaleness weather_fetch_staleness(const WeatherFetch_t *fetch, uint32_t now_ms);
+
+#endif // _JVDW_WEATHER_FETCH_H
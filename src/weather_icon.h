@@ -0,0 +1,79 @@
+#ifndef _JVDW_WEATHER_ICON_H
+#define _JVDW_WEATHER_ICON_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------------------------------------
+// Weather icon codes
+//
+// OpenWeatherMap reports the weather as an icon code such as "10d" or "01n". It is parsed once, when the
+// JSON comes in, into one byte: the low 7 bits are the kind of weather (an index into the icon bitmaps and
+// the procedural handlers) and the top bit marks the night variant. Nothing on the render path has to look
+// at the string again.
+// ----------------------------------------------------------------------------------------------------------
+enum WeatherIconKind : uint8_t
+{
+    IconClearSky = 0,
+    IconFewClouds,
+    IconScatteredClouds,
+    IconBrokenClouds,
+    IconShowerRain,
+    IconRain,
+    IconThunderstorm,
+    IconSnow,
+    IconMist,
+    WEATHER_ICON_KINDS,
+    IconUnknown = 0x7F
+};
+
+typedef uint8_t WeatherIcon_t;
+
+#define WEATHER_ICON_NIGHT 0x80
+#define WEATHER_ICON_NONE ((WeatherIcon_t)IconUnknown)
+
+// OpenWeatherMap number and bitmap file stem of each kind
+constexpr uint8_t WEATHER_ICON_OWM[WEATHER_ICON_KINDS] = {1, 2, 3, 4, 9, 10, 11, 13, 50};
+constexpr const char *WEATHER_ICON_STEM[WEATHER_ICON_KINDS] = {"01", "02", "03", "04", "09", "10", "11", "13", "50"};
+
+constexpr WeatherIconKind weather_icon_kind(WeatherIcon_t code) {
+    return (WeatherIconKind)(code & ~WEATHER_ICON_NIGHT);
+}
+
+constexpr bool weather_icon_night(WeatherIcon_t code) {
+    return (code & WEATHER_ICON_NIGHT) != 0;
+}
+
+constexpr bool weather_icon_valid(WeatherIcon_t code) {
+    return weather_icon_kind(code) < WEATHER_ICON_KINDS;
+}
+
+// For logging: the file stem ("10") and day/night letter of a code
+constexpr const char *weather_icon_stem(WeatherIcon_t code) {
+    return weather_icon_valid(code) ? WEATHER_ICON_STEM[weather_icon_kind(code)] : "??";
+}
+
+constexpr char weather_icon_suffix(WeatherIcon_t code) {
+    return weather_icon_night(code) ? 'n' : 'd';
+}
+
+// Kind for an OpenWeatherMap number, IconUnknown if there is none
+constexpr WeatherIconKind weather_icon_from_owm(uint8_t owm, uint8_t i = 0) {
+    return i == WEATHER_ICON_KINDS ? IconUnknown : WEATHER_ICON_OWM[i] == owm ? (WeatherIconKind)i : weather_icon_from_owm(owm, i + 1);
+}
+
+constexpr bool weather_icon_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Parse "NNd" / "NNn"; anything else gives an invalid code
+constexpr WeatherIcon_t weather_icon_parse(const char *s) {
+    return (s == nullptr || !weather_icon_digit(s[0]) || !weather_icon_digit(s[1]))
+               ? WEATHER_ICON_NONE
+               : (WeatherIcon_t)(weather_icon_from_owm((s[0] - '0') * 10 + (s[1] - '0')) | (s[2] == 'n' ? WEATHER_ICON_NIGHT : 0));
+}
+
+static_assert(weather_icon_parse("10n") == (IconRain | WEATHER_ICON_NIGHT), "weather_icon_parse");
+static_assert(weather_icon_parse("50d") == IconMist, "weather_icon_parse");
+static_assert(!weather_icon_valid(weather_icon_parse("12d")), "weather_icon_parse");
+
+#endif // _JVDW_WEATHER_ICON_H